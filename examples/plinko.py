@@ -3,7 +3,7 @@ import matplotlib.pyplot as plt
 from matplotlib.animation import FuncAnimation
 import numpy as np
 import random
-from Physics import ConstantGravity2d, Kinetics2d
+from Physics import EventDrivenKinetics2d
 from Boundaries import SphereCollider2d, BoxCollider2d
 
 def AnimateScatter(bounds, stepper, positions, colliders, frames=100, interval=50):
@@ -47,6 +47,7 @@ def AnimateScatter(bounds, stepper, positions, colliders, frames=100, interval=5
 if __name__ == "__main__":
     commandLine = CommandLineArguments(animate = True,
                                        numNodes = 80,
+                                       radius = 0.2,
                                        g = -9.8)
 
 
@@ -54,9 +55,10 @@ if __name__ == "__main__":
     myNodeList = NodeList(numNodes)
     gravVec = Vector2d(0, g)
 
-    constantGravity = ConstantGravity2d(myNodeList, constants, gravVec)
-    kinetics = Kinetics2d(myNodeList,constants)
-    packages = [constantGravity,kinetics]
+    # gravity is folded into the ballistic flights between collisions,
+    # so the event-driven package handles it on its own
+    kinetics = EventDrivenKinetics2d(myNodeList, constants, gravVec)
+    packages = [kinetics]
 
     colliders = []
     cbounds = []
@@ -81,14 +83,14 @@ if __name__ == "__main__":
     for bound in cbounds:
         kinetics.addBoundary(bound)
 
-    integrator = RungeKutta2Integrator2d(packages=packages, dtmin=0.01,verbose=False)
+    integrator = Integrator2d(packages=packages, dtmin=0.01,verbose=False)
     print(integrator)
 
 
     rad = myNodeList.getFieldDouble("radius")
     mass = myNodeList.getFieldDouble("mass")
     for i in range(numNodes):
-        rad.setValue(i, 0.2)
+        rad.setValue(i, radius)
         mass.setValue(i,0.2)
 
     print("numNodes =", myNodeList.numNodes)
@@ -96,8 +98,7 @@ if __name__ == "__main__":
 
     pos = myNodeList.getFieldVector2d("position")
 
-    for i in range(numNodes):
-        pos.setValue(i, Vector2d(random.uniform(-9, 9), 10))
+    myNodeList.updatePositions2d([[random.uniform(-9, 9), random.uniform(10, 12)] for i in range(numNodes)])
 
     controller = Controller(integrator=integrator, periodicWork=[], statStep=1)
 
@@ -5,6 +5,7 @@ PYB11includes = ['"boundary.hh"',
                  '"reflectingGridBoundary.cc"',
                  '"periodicGridBoundary.cc"',
                  '"outflowGridBoundary.cc"',
+                 '"absorbingGridBoundary.cc"',
                  '"dirichletGridBoundary.cc"',
                  '"sphereCollider.cc"',
                  '"boxCollider.cc"',
@@ -17,6 +18,7 @@ from gridBoundary import *
 from reflectingGridBoundary import *
 from periodicGridBoundary import *
 from outflowGridBoundary import *
+from absorbingGridBoundary import *
 from dirichletGridBoundary import *
 from sphereCollider import *
 from boxCollider import *
@@ -0,0 +1,64 @@
+// Copyright (C) 2025  Cody Raskin
+
+#pragma once
+
+#include <vector>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include "gridBoundary.hh"
+
+// Perfectly matched layer of `thickness` cells along every edge of the grid. It doesn't
+// touch the state itself: a package that supports it (WaveEquation) stretches each axis
+// by 1 + sigma_k / (i omega) in the layer cells. Along each axis sigma_k rises from 0 at
+// the inner edge of the layer as (depth/thickness)^order, and is scaled so that a wave that
+// crosses the layer and comes back at normal incidence is left with `reflection` of its
+// amplitude. Only the layer cells are stored, with sigma_k / c for each axis.
+template <int dim>
+class AbsorbingGridBoundary : public GridBoundary<dim> {
+protected:
+    int thickness;
+    double reflection;
+    int order;
+    std::vector<int> ids;           // layer cells
+    std::vector<double> profile;    // dim per layer cell: sigma_k / c
+public:
+    AbsorbingGridBoundary(Mesh::Grid<dim>* grid, int thickness, double reflection = 1e-3, int order = 2) :
+        GridBoundary<dim>(grid), thickness(thickness), reflection(reflection), order(order) {
+        if (thickness < 1)
+            throw std::invalid_argument("AbsorbingGridBoundary: thickness must be at least one cell");
+        if (!(reflection > 0.0 && reflection < 1.0))
+            throw std::invalid_argument("AbsorbingGridBoundary: reflection must be between 0 and 1");
+        if (order < 0)
+            throw std::invalid_argument("AbsorbingGridBoundary: order must be non-negative");
+
+        // the integral of sigma across the layer is -c ln(reflection) / 2
+        const double strength = 0.5 * (order + 1) * std::log(1.0 / reflection);
+        const std::array<int, 3> n = {grid->nx, grid->ny, grid->nz};
+        for (int i = 0; i < grid->size(); ++i) {
+            const std::array<int, 3> c = grid->indexToCoordinates(i);
+            std::array<double, dim> s;
+            bool inLayer = false;
+            for (int k = 0; k < dim; ++k) {
+                const int edge = std::min(c[k], n[k] - 1 - c[k]);
+                s[k] = 0.0;
+                if (edge >= thickness) continue;
+                const double depth = (thickness - edge - 0.5) / thickness;
+                s[k] = strength / (thickness * grid->spacing(k)) * std::pow(depth, order);
+                inLayer = true;
+            }
+            if (inLayer) {
+                ids.push_back(i);
+                profile.insert(profile.end(), s.begin(), s.end());
+            }
+        }
+    }
+
+    virtual ~AbsorbingGridBoundary() {}
+
+    inline const std::vector<int>& getIds() const { return ids; }
+    inline const std::vector<double>& getProfile() const { return profile; }
+    inline int getThickness() const { return thickness; }
+    inline double getReflection() const { return reflection; }
+    inline int getOrder() const { return order; }
+};
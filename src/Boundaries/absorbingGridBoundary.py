@@ -0,0 +1,30 @@
+from PYB11Generator import *
+from gridBoundary import *
+
+@PYB11template("dim")
+class AbsorbingGridBoundary(GridBoundary):
+    def pyinit(self,
+               grid="Mesh::Grid<%(dim)s>*",
+               thickness="int",
+               reflection=("double","1e-3"),
+               order=("int","2")):
+        return
+    thickness = PYB11property("int", getter="getThickness", doc="Cells in the layer along each edge.")
+    reflection = PYB11property("double", getter="getReflection", doc="Amplitude left after crossing the layer and back at normal incidence.")
+    order = PYB11property("int", getter="getOrder", doc="Power of the depth in the damping profile.")
+    
+AbsorbingGridBoundary1d = PYB11TemplateClass(AbsorbingGridBoundary,
+                              template_parameters = ("1"),
+                              cppname = "AbsorbingGridBoundary<1>",
+                              pyname = "AbsorbingGridBoundary1d",
+                              docext = " (1D).")
+AbsorbingGridBoundary2d = PYB11TemplateClass(AbsorbingGridBoundary,
+                              template_parameters = ("2"),
+                              cppname = "AbsorbingGridBoundary<2>",
+                              pyname = "AbsorbingGridBoundary2d",
+                              docext = " (2D).")
+AbsorbingGridBoundary3d = PYB11TemplateClass(AbsorbingGridBoundary,
+                              template_parameters = ("3"),
+                              cppname = "AbsorbingGridBoundary<3>",
+                              pyname = "AbsorbingGridBoundary3d",
+                              docext = " (3D).")
@@ -59,6 +59,14 @@ Field<T>::setValue(const unsigned int index, T val) {
     values[index] = val; 
 }
 
+template <typename T>
+void 
+Field<T>::setValues(const std::vector<T>& newValues) { 
+    if (newValues.size() != values.size())
+        throw std::runtime_error("setValues: size mismatch between input and field");
+    values = newValues; 
+}
+
 template <typename T>
 T& 
 Field<T>::operator[](const unsigned int index) { 
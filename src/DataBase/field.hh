@@ -7,6 +7,7 @@
 #include <vector>
 #include <memory>
 #include <complex>
+#include <stdexcept>
 #include "../Type/name.hh"
 
 // Base class for all Field types
@@ -38,6 +39,7 @@ public:
     const std::vector<T>& getValues() const;
     const T& getValue(const unsigned int index) const;
     void setValue(const unsigned int index, T val);
+    void setValues(const std::vector<T>& newValues);
     T& operator[](const unsigned int index);
     const T& operator[](const unsigned int index) const;
 
@@ -52,6 +52,10 @@ class Field(FieldBase):
     def setValue(self,i="int",val="%(T)s"):
         return
 
+    def setValues(self,newValues="const std::vector<FieldType>&"):
+        "Replace every value at once"
+        return
+
 
         
     name = PYB11property("std::string", getter="getNameString", doc="The name of the Field.")
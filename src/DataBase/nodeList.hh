@@ -6,6 +6,8 @@
 #include <vector>
 #include <string>
 #include <memory> // Include for std::shared_ptr
+#include <map>
+#include <mutex>
 #include "field.hh"
 #include "../Type/name.hh"
 #include "../Math/vectorMath.hh"
@@ -17,6 +19,17 @@ private:
     Field<int> _ids;
     std::vector<std::shared_ptr<FieldBase>> _extraFields;
 
+    // objects built from these nodes and handed out by getShared; a copy of the
+    // NodeList starts without them
+    struct SharedObjects {
+        std::map<std::string, std::weak_ptr<void>> objects;
+        std::mutex mutex;
+        SharedObjects() {}
+        SharedObjects(const SharedObjects&) {}
+        SharedObjects& operator=(const SharedObjects&) { return *this; }
+    };
+    SharedObjects _shared;
+
 public:
     NodeList();
     NodeList(int numNodes);
@@ -63,6 +76,20 @@ public:
     Field<int>& nodes();
     unsigned int size() const;
 
+    // The object stored under key, built with make() if no caller still holds one.
+    // It lives on the NodeList rather than in a static so that every Python module
+    // handed this NodeList finds the same object. Safe to call from several threads.
+    template <typename T, typename Make>
+    std::shared_ptr<T> getShared(const std::string& key, Make&& make) {
+        std::lock_guard<std::mutex> lock(_shared.mutex);
+        std::weak_ptr<void>& slot = _shared.objects[key];
+        if (auto existing = slot.lock())
+            return std::static_pointer_cast<T>(existing);
+        std::shared_ptr<T> made = make();
+        slot = made;
+        return made;
+    }
+
     template <int dim>
     void updatePositions(const std::vector<std::array<double, dim>>& py_positions) {
         Field<Lin::Vector<dim>>& posField = *this->position<dim>();
@@ -79,6 +106,23 @@ public:
             posField.setValue(i, v);
         }
     }
+
+    template <int dim>
+    void updateVelocities(const std::vector<std::array<double, dim>>& py_velocities) {
+        Field<Lin::Vector<dim>>& velField = *this->velocity<dim>();
+
+        if (py_velocities.size() != velField.size()) {
+            throw std::runtime_error("updateVelocities: size mismatch between input and field");
+        }
+
+        for (size_t i = 0; i < py_velocities.size(); ++i) {
+            Lin::Vector<dim> v;
+            for (int d = 0; d < dim; ++d) {
+                v[d] = py_velocities[i][d];
+            }
+            velField.setValue(i, v);
+        }
+    }
 };
 
 #include "nodeList.cc" // Include the template implementation
@@ -29,6 +29,9 @@ class NodeList:
     @PYB11template("dim")
     def updatePositions(self, py_positions="std::vector<std::array>&"):
         return
+    @PYB11template("dim")
+    def updateVelocities(self, py_velocities="std::vector<std::array>&"):
+        return
     numNodes = PYB11property("int", getter="getNumNodes", doc="The number of nodes in the nodeList.")
     count = PYB11property("int", getter="getFieldCount", doc="The number of fields in the nodeList.")
     fieldNames = PYB11property("std::vector<std::string>", getter="fieldNames", doc="The names of fields in the nodeList.")
@@ -47,6 +50,10 @@ class NodeList:
                                 template_parameters = ("3"),pyname="position")
     getFieldDouble = PYB11TemplateMethod(getField,
                                 template_parameters = ("double"))
+    getFieldFloat = PYB11TemplateMethod(getField,
+                                template_parameters = ("float"))
+    getFieldInt = PYB11TemplateMethod(getField,
+                                template_parameters = ("int"))
     getFieldComplex = PYB11TemplateMethod(getField,
                                 template_parameters = ("std::complex<double>"))
     getFieldVector1d = PYB11TemplateMethod(getField,
@@ -70,4 +77,10 @@ class NodeList:
     updatePositions2d  = PYB11TemplateMethod(updatePositions,
                                 template_parameters  =  ("2"))
     updatePositions3d = PYB11TemplateMethod(updatePositions,
-                                template_parameters  = ("3"))
\ No newline at end of file
+                                template_parameters  = ("3"))
+    updateVelocities1d = PYB11TemplateMethod(updateVelocities,
+                                template_parameters = ("1"))
+    updateVelocities2d = PYB11TemplateMethod(updateVelocities,
+                                template_parameters = ("2"))
+    updateVelocities3d = PYB11TemplateMethod(updateVelocities,
+                                template_parameters = ("3"))
\ No newline at end of file
@@ -5,7 +5,8 @@ PYB11includes = ['"equationOfState.hh"',
                  '"mieGruneisenEOS.cc"',
                  '"helmholtzEOS.cc"',
                  '"tillotsonEOS.cc"',
-                 '"isothermalEOS.cc"',]
+                 '"isothermalEOS.cc"',
+                 '"tabulatedEOS.cc"',]
 
 from equationOfState import *
 from idealGasEOS import *
@@ -14,3 +15,4 @@ from mieGruneisenEOS import *
 from helmholtzEOS import *
 from tillotsonEOS import *
 from isothermalEOS import *
+from tabulatedEOS import *
@@ -1,7 +1,168 @@
 // Copyright (C) 2025  Cody Raskin
 
 #include "eosTable.hh"
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
 
+inline
 EOSTable::EOSTable(std::vector<std::vector<double>> table,
             std::vector<double> x, std::vector<double> y)
-        : values(std::move(table)), xgrid(std::move(x)), ygrid(std::move(y)) {}
\ No newline at end of file
+        : xgrid(std::move(x)), ygrid(std::move(y)), nx(xgrid.size()), ny(ygrid.size()) {
+    if (table.size() != nx)
+        throw std::invalid_argument("EOSTable: table rows don't match the x axis");
+    auto flat = std::make_shared<std::vector<double>>(nx * ny);
+    for (size_t i = 0; i < nx; ++i) {
+        if (table[i].size() != ny)
+            throw std::invalid_argument("EOSTable: table columns don't match the y axis");
+        std::copy(table[i].begin(), table[i].end(), flat->begin() + i * ny);
+    }
+    values = flat->data();
+    storage = flat;
+    xUniform = isUniform(xgrid, dxInv);
+    yUniform = isUniform(ygrid, dyInv);
+}
+
+inline
+EOSTable::EOSTable(std::vector<double> table,
+            std::vector<double> x, std::vector<double> y)
+        : xgrid(std::move(x)), ygrid(std::move(y)), nx(xgrid.size()), ny(ygrid.size()) {
+    if (table.size() != nx * ny)
+        throw std::invalid_argument("EOSTable: table size doesn't match the axes");
+    auto flat = std::make_shared<std::vector<double>>(std::move(table));
+    values = flat->data();
+    storage = flat;
+    xUniform = isUniform(xgrid, dxInv);
+    yUniform = isUniform(ygrid, dyInv);
+}
+
+inline
+EOSTable::EOSTable(std::shared_ptr<const void> storage, const double* table,
+            std::vector<double> x, std::vector<double> y)
+        : storage(std::move(storage)), values(table),
+          xgrid(std::move(x)), ygrid(std::move(y)), nx(xgrid.size()), ny(ygrid.size()) {
+    xUniform = isUniform(xgrid, dxInv);
+    yUniform = isUniform(ygrid, dyInv);
+}
+
+// evenly spaced to within what a table written with ten significant digits can hold
+inline bool
+EOSTable::isUniform(const std::vector<double>& grid, double& hInv) {
+    if (grid.size() < 2) return false;
+    const double h = (grid.back() - grid.front()) / (grid.size() - 1);
+    if (h <= 0.0) return false;
+    const double tol = 1e-6 * h;
+    for (size_t k = 0; k < grid.size(); ++k)
+        if (std::abs(grid[k] - (grid.front() + k * h)) > tol) return false;
+    hInv = 1.0 / h;
+    return true;
+}
+
+// lower node of the cell holding x; points off the table use the edge cell
+inline size_t
+EOSTable::findCell(const std::vector<double>& grid, bool uniform, double hInv, double x) {
+    const long last = (long)grid.size() - 2;
+    long k;
+    if (uniform) {
+        const double r = (x - grid.front()) * hInv;
+        k = (r <= 0.0 ? 0 : (r >= last ? last : (long)r));
+    } else {
+        k = (long)(std::upper_bound(grid.begin(), grid.end(), x) - grid.begin()) - 1;
+    }
+    return (size_t)std::min(std::max(k, 0L), last);
+}
+
+// Fritsch-Butland slope at a node from the secants on either side: their harmonic
+// mean, or 0 at an extremum, which keeps the cubic monotone wherever the data are
+inline double
+EOSTable::monotoneSlope(double a, double b) {
+    return (a * b <= 0.0 ? 0.0 : 2.0 * a * b / (a + b));
+}
+
+// slope at the end of the table from a one-sided three-point difference, where d is the
+// secant of the edge cell (width h) and dn that of its neighbor (width hn), pulled back
+// to keep the edge cell monotone
+inline double
+EOSTable::endSlope(double h, double hn, double d, double dn) {
+    double m = ((2.0 * h + hn) * d - h * dn) / (h + hn);
+    if (m * d <= 0.0) return 0.0;
+    if (d * dn <= 0.0 && std::abs(m) > 3.0 * std::abs(d)) return 3.0 * d;
+    return m;
+}
+
+// monotone-limited derivative at node k of values f(m) on the axis g
+template <typename F>
+inline double
+EOSTable::nodeSlope(const std::vector<double>& g, size_t k, const F& f) {
+    const size_t n = g.size();
+    if (n == 2) return (f(1) - f(0)) / (g[1] - g[0]);
+    if (k == 0)
+        return endSlope(g[1] - g[0], g[2] - g[1], (f(1) - f(0)) / (g[1] - g[0]), (f(2) - f(1)) / (g[2] - g[1]));
+    if (k == n - 1)
+        return endSlope(g[n - 1] - g[n - 2], g[n - 2] - g[n - 3],
+                        (f(n - 1) - f(n - 2)) / (g[n - 1] - g[n - 2]), (f(n - 2) - f(n - 3)) / (g[n - 2] - g[n - 3]));
+    return monotoneSlope((f(k) - f(k - 1)) / (g[k] - g[k - 1]), (f(k + 1) - f(k)) / (g[k + 1] - g[k]));
+}
+
+inline void
+EOSTable::buildHermite() {
+    auto h = std::make_shared<std::vector<double>>(4 * nx * ny);
+    std::vector<double>& H = *h;
+    #pragma omp parallel for
+    for (long ij = 0; ij < (long)(nx * ny); ++ij) {
+        const size_t i = ij / ny, j = ij % ny;
+        H[4 * ij]     = at(i, j);
+        H[4 * ij + 1] = nodeSlope(xgrid, i, [this, j](size_t m) { return at(m, j); });
+        H[4 * ij + 2] = nodeSlope(ygrid, j, [this, i](size_t m) { return at(i, m); });
+    }
+    // the twist is the x derivative of the y slopes, limited the same way
+    #pragma omp parallel for
+    for (long ij = 0; ij < (long)(nx * ny); ++ij) {
+        const size_t i = ij / ny, j = ij % ny;
+        H[4 * ij + 3] = nodeSlope(xgrid, i, [&H, j, this](size_t m) { return H[4 * (m * ny + j) + 2]; });
+    }
+    hermite = h;
+}
+
+inline void
+EOSTable::setInterpolation(Interpolation value) {
+    interpolation = value;
+    if (interpolation == Interpolation::MonotoneCubic && !hermite && nx > 1 && ny > 1)
+        buildHermite();
+}
+
+inline double
+EOSTable::interpolate(const Stencil& s) const {
+    if (interpolation == Interpolation::Bilinear) {
+        return (1 - s.tx) * (1 - s.ty) * at(s.i, s.j) +
+               (1 - s.tx) * s.ty       * at(s.i, s.j + 1) +
+               s.tx       * (1 - s.ty) * at(s.i + 1, s.j) +
+               s.tx       * s.ty       * at(s.i + 1, s.j + 1);
+    }
+    // bicubic Hermite on the cell from the values and derivatives at its corners
+    const double hx = xgrid[s.i + 1] - xgrid[s.i];
+    const double hy = ygrid[s.j + 1] - ygrid[s.j];
+    const double tx2 = s.tx * s.tx, tx3 = tx2 * s.tx;
+    const double ty2 = s.ty * s.ty, ty3 = ty2 * s.ty;
+    const double Hx[2] = {2 * tx3 - 3 * tx2 + 1, -2 * tx3 + 3 * tx2};
+    const double Gx[2] = {hx * (tx3 - 2 * tx2 + s.tx), hx * (tx3 - tx2)};
+    const double Hy[2] = {2 * ty3 - 3 * ty2 + 1, -2 * ty3 + 3 * ty2};
+    const double Gy[2] = {hy * (ty3 - 2 * ty2 + s.ty), hy * (ty3 - ty2)};
+
+    const double* H = hermite->data();
+    double f = 0.0;
+    for (int a = 0; a < 2; ++a)
+        for (int b = 0; b < 2; ++b) {
+            const double* node = H + 4 * ((s.i + a) * ny + s.j + b);
+            f += Hx[a] * Hy[b] * node[0] + Gx[a] * Hy[b] * node[1] +
+                 Hx[a] * Gy[b] * node[2] + Gx[a] * Gy[b] * node[3];
+        }
+    return f;
+}
+
+inline void
+EOSTable::interpolate(double* out, const double* x, const double* y, const int n) const {
+    #pragma omp parallel for
+    for (int k = 0; k < n; ++k)
+        out[k] = interpolate(locate(x[k], y[k]));
+}
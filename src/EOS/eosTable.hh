@@ -3,20 +3,87 @@
 #pragma once
 
 #include <vector>
+#include <string>
+#include <memory>
 #include "../Math/scalarMath.hh"
 
+// A 2D table f(x, y) on a tensor grid, stored flat and row-major (x slowest). Axes that
+// are evenly spaced, like the log rho / log u grids of HelmholtzEOS, are detected on
+// construction and located by direct index arithmetic instead of a binary search.
+// Lookups are bilinear by default, or bicubic Hermite with monotone-limited node
+// derivatives (computed once, when the mode is selected), which keeps the same
+// accuracy on a much coarser table without overshooting between nodes. The values may
+// be owned by the table or be a view into memory held by someone else, e.g. a mapped
+// EOSTableFile; copies share them either way.
 class EOSTable {
-    std::vector<std::vector<double>> values;
+public:
+    enum class Interpolation { Bilinear, MonotoneCubic };
+
+    // the bracketing cell and weights of a point, so several tables on the
+    // same axes can be read without repeating the search
+    struct Stencil {
+        size_t i, j;
+        double tx, ty;
+    };
+
+private:
+    std::shared_ptr<const void> storage;   // keeps values alive
+    const double* values = nullptr;
     std::vector<double> xgrid, ygrid;
+    size_t nx = 0, ny = 0;
+    bool xUniform = false, yUniform = false;
+    double dxInv = 0.0, dyInv = 0.0;
+    Interpolation interpolation = Interpolation::Bilinear;
+    std::shared_ptr<const std::vector<double>> hermite;   // f, df/dx, df/dy, d2f/dxdy per node
+
+    static bool isUniform(const std::vector<double>& grid, double& hInv);
+    static size_t findCell(const std::vector<double>& grid, bool uniform, double hInv, double x);
+    static double monotoneSlope(double a, double b);
+    static double endSlope(double h, double hn, double d, double dn);
+    template <typename F>
+    static double nodeSlope(const std::vector<double>& g, size_t k, const F& f);
+    void buildHermite();
+
+    inline double at(size_t i, size_t j) const { return values[i * ny + j]; }
 
 public:
     EOSTable() = default;
     EOSTable(std::vector<std::vector<double>> table,
             std::vector<double> x, std::vector<double> y);
+    // table holds x.size()*y.size() values, row-major
+    EOSTable(std::vector<double> table,
+            std::vector<double> x, std::vector<double> y);
+    // a view of x.size()*y.size() row-major values that storage keeps alive
+    EOSTable(std::shared_ptr<const void> storage, const double* table,
+            std::vector<double> x, std::vector<double> y);
+
+    Stencil locate(double x, double y) const {
+        Stencil s;
+        s.i = findCell(xgrid, xUniform, dxInv, x);
+        s.j = findCell(ygrid, yUniform, dyInv, y);
+        s.tx = (x - xgrid[s.i]) / (xgrid[s.i + 1] - xgrid[s.i]);
+        s.ty = (y - ygrid[s.j]) / (ygrid[s.j + 1] - ygrid[s.j]);
+        return s;
+    }
+
+    double interpolate(const Stencil& s) const;
 
     double interpolate(double x, double y) const {
-        return Lin::bilinearInterp(values, xgrid, ygrid, x, y);
+        return interpolate(locate(x, y));
     }
+
+    // out[k] = f(x[k], y[k]) for k < n
+    void interpolate(double* out, const double* x, const double* y, const int n) const;
+
+    void setInterpolation(Interpolation value);
+    inline Interpolation getInterpolation() const { return interpolation; }
+    inline bool uniformX() const { return xUniform; }
+    inline bool uniformY() const { return yUniform; }
+    inline size_t sizeX() const { return nx; }
+    inline size_t sizeY() const { return ny; }
+    inline const double* data() const { return values; }
+    inline const std::vector<double>& getXGrid() const { return xgrid; }
+    inline const std::vector<double>& getYGrid() const { return ygrid; }
 };
 
 #include "eosTable.cc"
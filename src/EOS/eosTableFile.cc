@@ -0,0 +1,101 @@
+// Copyright (C) 2025  Cody Raskin
+
+#include "eosTableFile.hh"
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+inline
+EOSTableFile::Mapping::~Mapping() {
+    if (address) munmap(address, length);
+}
+
+inline
+EOSTableFile::EOSTableFile(const std::string& filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("EOSTableFile: failed to open " + filename);
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(Header)) {
+        ::close(fd);
+        throw std::runtime_error("EOSTableFile: " + filename + " is too short to be a table");
+    }
+
+    mapping = std::make_shared<Mapping>();
+    mapping->length = st.st_size;
+    mapping->address = mmap(nullptr, mapping->length, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping->address == MAP_FAILED) {
+        mapping->address = nullptr;
+        throw std::runtime_error("EOSTableFile: failed to map " + filename);
+    }
+
+    std::memcpy(&header, mapping->address, sizeof(Header));
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0)
+        throw std::runtime_error("EOSTableFile: " + filename + " is not a binary EOS table");
+    if (header.version != formatVersion)
+        throw std::runtime_error("EOSTableFile: " + filename + " has format version " +
+                                 std::to_string(header.version) + ", expected " +
+                                 std::to_string(formatVersion) + "; regenerate it");
+    const size_t expected = sizeof(Header) +
+        sizeof(double) * (header.nx + header.ny + header.numTables * header.nx * header.ny);
+    if (mapping->length < expected)
+        throw std::runtime_error("EOSTableFile: " + filename + " is truncated");
+
+    const double* axes = reinterpret_cast<const double*>(static_cast<const char*>(mapping->address) + sizeof(Header));
+    xgrid.assign(axes, axes + header.nx);
+    ygrid.assign(axes + header.nx, axes + header.nx + header.ny);
+}
+
+inline const double*
+EOSTableFile::tableData(size_t k) const {
+    const double* axes = reinterpret_cast<const double*>(static_cast<const char*>(mapping->address) + sizeof(Header));
+    return axes + header.nx + header.ny + k * header.nx * header.ny;
+}
+
+inline EOSTable
+EOSTableFile::table(size_t k) const {
+    if (k >= header.numTables)
+        throw std::out_of_range("EOSTableFile: no table " + std::to_string(k));
+    return EOSTable(mapping, tableData(k), xgrid, ygrid);
+}
+
+inline bool
+EOSTableFile::isBinary(const std::string& filename) {
+    FILE* fp = std::fopen(filename.c_str(), "rb");
+    if (!fp) return false;
+    char head[sizeof(magic)];
+    bool match = std::fread(head, 1, sizeof(head), fp) == sizeof(head) &&
+                 std::memcmp(head, magic, sizeof(magic)) == 0;
+    std::fclose(fp);
+    return match;
+}
+
+inline void
+EOSTableFile::write(const std::string& filename, const std::vector<double>& x,
+                    const std::vector<double>& y, const std::vector<const double*>& tables) {
+    Header h;
+    std::memcpy(h.magic, magic, sizeof(magic));
+    h.version = formatVersion;
+    h.numTables = tables.size();
+    h.nx = x.size();
+    h.ny = y.size();
+
+    const std::string tmp = filename + ".tmp" + std::to_string(getpid());
+    FILE* fp = std::fopen(tmp.c_str(), "wb");
+    if (!fp) throw std::runtime_error("EOSTableFile: could not open " + tmp + " for writing");
+    bool ok = std::fwrite(&h, sizeof(Header), 1, fp) == 1 &&
+              std::fwrite(x.data(), sizeof(double), x.size(), fp) == x.size() &&
+              std::fwrite(y.data(), sizeof(double), y.size(), fp) == y.size();
+    for (const double* t : tables)
+        ok = ok && std::fwrite(t, sizeof(double), x.size() * y.size(), fp) == x.size() * y.size();
+    ok = (std::fclose(fp) == 0) && ok;
+    if (!ok || std::rename(tmp.c_str(), filename.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        throw std::runtime_error("EOSTableFile: failed writing " + filename);
+    }
+}
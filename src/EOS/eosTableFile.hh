@@ -0,0 +1,58 @@
+// Copyright (C) 2025  Cody Raskin
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+#include "eosTable.hh"
+
+// Binary EOS tables: a fixed header, the two axes, then any number of row-major tables
+// on them, all as host-endian doubles. Opening a file maps it read-only, so the jobs of
+// a parameter sweep on one node share the same pages and start up without parsing.
+class EOSTableFile {
+public:
+    static constexpr uint32_t formatVersion = 1;
+
+    struct Header {
+        char magic[8];          // "YGGEOSTB"
+        uint32_t version;
+        uint32_t numTables;
+        uint64_t nx, ny;
+    };
+
+    explicit EOSTableFile(const std::string& filename);
+
+    inline size_t numTables() const { return header.numTables; }
+    inline const std::vector<double>& getXGrid() const { return xgrid; }
+    inline const std::vector<double>& getYGrid() const { return ygrid; }
+
+    // table k as a view into the mapping, which stays open while any view exists
+    EOSTable table(size_t k) const;
+
+    // true if filename starts with the binary table magic
+    static bool isBinary(const std::string& filename);
+
+    // each of tables holds x.size()*y.size() row-major values. Written to a temporary
+    // and renamed into place, so a reader never sees a partial file
+    static void write(const std::string& filename, const std::vector<double>& x,
+                      const std::vector<double>& y, const std::vector<const double*>& tables);
+
+private:
+    static constexpr char magic[8] = {'Y','G','G','E','O','S','T','B'};
+
+    struct Mapping {
+        void* address = nullptr;
+        size_t length = 0;
+        ~Mapping();
+    };
+
+    std::shared_ptr<Mapping> mapping;
+    Header header;
+    std::vector<double> xgrid, ygrid;
+
+    const double* tableData(size_t k) const;
+};
+
+#include "eosTableFile.cc"
@@ -4,6 +4,8 @@
 #define EQUATIONOFSTATE_HH
 
 #include <vector>
+#include <cmath>
+#include <algorithm>
 #include "../Type/physicalConstants.hh"
 #include "../DataBase/field.hh"
 
@@ -48,8 +50,81 @@ public:
     virtual void 
     setInternalEnergyFromTemperature(double* internalEnergy, double* density, double* temperature) const = 0;
 
+    // Batched methods: n contiguous inputs to n contiguous outputs. The defaults just loop
+    // over the scalar methods; EOSs with closed forms override them with omp parallel simd loops.
+
+    virtual void
+    setPressure(double* pressure, const double* density, const double* internalEnergy, const int n) const {
+        for (int i = 0; i < n; ++i)
+            setPressure(&pressure[i], const_cast<double*>(&density[i]), const_cast<double*>(&internalEnergy[i]));
+    }
+
+    virtual void
+    setInternalEnergy(double* internalEnergy, const double* density, const double* pressure, const int n) const {
+        for (int i = 0; i < n; ++i)
+            setInternalEnergy(&internalEnergy[i], const_cast<double*>(&density[i]), const_cast<double*>(&pressure[i]));
+    }
+
+    virtual void
+    setSoundSpeed(double* soundSpeed, const double* density, const double* internalEnergy, const int n) const {
+        for (int i = 0; i < n; ++i)
+            setSoundSpeed(&soundSpeed[i], const_cast<double*>(&density[i]), const_cast<double*>(&internalEnergy[i]));
+    }
+
+    virtual void
+    setTemperature(double* temperature, const double* density, const double* internalEnergy, const int n) const {
+        for (int i = 0; i < n; ++i)
+            setTemperature(&temperature[i], const_cast<double*>(&density[i]), const_cast<double*>(&internalEnergy[i]));
+    }
+
+    virtual void
+    setInternalEnergyFromTemperature(double* internalEnergy, const double* density, const double* temperature, const int n) const {
+        for (int i = 0; i < n; ++i)
+            setInternalEnergyFromTemperature(&internalEnergy[i], const_cast<double*>(&density[i]), const_cast<double*>(&temperature[i]));
+    }
+
+    // Everything the hydro needs from one (density, internalEnergy) state in a single call:
+    // pressure and sound speed always, temperature, adiabatic index rho cs^2 / P and
+    // cv = du/dT at fixed density wherever the pointer isn't null. The default makes the
+    // separate batched calls; table EOSs override it to locate each state once and reuse
+    // the interpolation weights for every output.
+    virtual void
+    setThermodynamicState(double* pressure, double* soundSpeed, double* temperature, double* gamma, double* cv,
+                          const double* density, const double* internalEnergy, const int n) const {
+        setPressure(pressure, density, internalEnergy, n);
+        setSoundSpeed(soundSpeed, density, internalEnergy, n);
+        if (temperature)
+            setTemperature(temperature, density, internalEnergy, n);
+        if (gamma) {
+            #pragma omp parallel for simd
+            for (int i = 0; i < n; ++i)
+                gamma[i] = (pressure[i] > 0.0 ? density[i] * soundSpeed[i] * soundSpeed[i] / pressure[i] : 0.0);
+        }
+        if (cv) {
+            std::vector<double> T0(n), T1(n), u1(n);
+            for (int i = 0; i < n; ++i)
+                u1[i] = internalEnergy[i] + std::max(std::abs(internalEnergy[i]) * 1e-4, 1e-10);
+            setTemperature(T0.data(), density, internalEnergy, n);
+            setTemperature(T1.data(), density, u1.data(), n);
+            for (int i = 0; i < n; ++i)
+                cv[i] = (T1[i] != T0[i] ? (u1[i] - internalEnergy[i]) / (T1[i] - T0[i]) : 0.0);
+        }
+    }
+
+    // Field version for the bindings; temperature may be null
+    void
+    setThermodynamicState(Field<double>* pressure, Field<double>* soundSpeed, Field<double>* density,
+                          Field<double>* internalEnergy, Field<double>* temperature = nullptr) const {
+        setThermodynamicState(data(pressure), data(soundSpeed), (temperature ? data(temperature) : nullptr),
+                              nullptr, nullptr, data(density), data(internalEnergy), density->size());
+    }
+
     virtual std::string 
     name() const = 0;
+
+    // contiguous storage of a Field, for handing it to the batched methods
+    static double*
+    data(Field<double>* field) { return field->size() > 0 ? &(*field)[0] : nullptr; }
 };
 
 #endif // EQUATIONOFSTATE_HH
\ No newline at end of file
@@ -4,6 +4,16 @@ from EOSAbstractMethods import *
 class EquationOfState:
     def pyinit(self,constants="PhysicalConstants&"):
         return
+
+    @PYB11const
+    def setThermodynamicState(self,
+                              pressure = "Field<double>*",
+                              soundSpeed = "Field<double>*",
+                              density = "Field<double>*",
+                              internalEnergy = "Field<double>*",
+                              temperature = ("Field<double>*", "nullptr")):
+        "Pressure, sound speed and optionally temperature in a single pass"
+        return "void"
     
 #-------------------------------------------------------------------------------
 # Add the virtual interface
@@ -9,6 +9,7 @@
 #include <stdexcept>
 #include "equationOfState.hh"
 #include "eosTable.hh"
+#include "eosTableFile.hh"
 
 class HelmholtzEOS : public EquationOfState {
 private:
@@ -20,10 +21,12 @@ private:
     EOSTable CsTable;
 
     const PhysicalConstants constants;
-    const std::string& tableFile;
+    const std::string tableFile;
 
-    void 
-    loadTable(const std::string& filename) {
+    // parse a text table of "logRho logU P cs" rows into flat row-major P, u and cs
+    static void
+    readTextTable(const std::string& filename, std::vector<double>& logRho, std::vector<double>& logU,
+                  std::vector<double>& P, std::vector<double>& U, std::vector<double>& Cs) {
         FILE* file = std::fopen(filename.c_str(), "r");
         if (!file) {
             throw std::runtime_error("Failed to open EOS table: " + filename);
@@ -35,54 +38,71 @@ private:
 
         // Read file into raw vectors
         while (std::fgets(line, sizeof(line), file)) {
-            double logRho, logU, P, cs;
-            int count = std::sscanf(line, "%lf %lf %lf %lf", &logRho, &logU, &P, &cs);
+            double lr, lu, p, cs;
+            int count = std::sscanf(line, "%lf %lf %lf %lf", &lr, &lu, &p, &cs);
             if (count != 4) continue;
 
-            rows.emplace_back(logRho, logU, P, cs);
-            rawRhos.insert(logRho);
-            rawUs.insert(logU);
+            rows.emplace_back(lr, lu, p, cs);
+            rawRhos.insert(lr);
+            rawUs.insert(lu);
         }
         std::fclose(file);
 
         // Deduplicate and sort axis grids
-        logRhoGrid.assign(rawRhos.begin(), rawRhos.end());
-        logUGrid.assign(rawUs.begin(), rawUs.end());
-
-        const size_t nRho = logRhoGrid.size();
-        const size_t nU   = logUGrid.size();
+        logRho.assign(rawRhos.begin(), rawRhos.end());
+        logU.assign(rawUs.begin(), rawUs.end());
 
-        std::vector<std::vector<double>> PTableData(nRho, std::vector<double>(nU));
-        std::vector<std::vector<double>> UTableData(nRho, std::vector<double>(nU));
-        std::vector<std::vector<double>> CsTableData(nRho, std::vector<double>(nU));
+        const size_t nRho = logRho.size();
+        const size_t nU   = logU.size();
+        P.assign(nRho * nU, 0.0);
+        U.assign(nRho * nU, 0.0);
+        Cs.assign(nRho * nU, 0.0);
 
         // Build lookup maps from value to index for fast lookup
         std::unordered_map<double, size_t> rhoIndex, uIndex;
-        for (size_t i = 0; i < nRho; ++i) rhoIndex[logRhoGrid[i]] = i;
-        for (size_t j = 0; j < nU; ++j)   uIndex[logUGrid[j]] = j;
+        for (size_t i = 0; i < nRho; ++i) rhoIndex[logRho[i]] = i;
+        for (size_t j = 0; j < nU; ++j)   uIndex[logU[j]] = j;
 
         // Populate tables
-        for (const auto& [logRho, logU, P, cs] : rows) {
-            auto itRho = rhoIndex.find(logRho);
-            auto itU   = uIndex.find(logU);
-            if (itRho == rhoIndex.end() || itU == uIndex.end()) continue;
+        for (const auto& [lr, lu, p, cs] : rows) {
+            size_t k = rhoIndex[lr] * nU + uIndex[lu];
+            P[k]  = p;
+            U[k]  = std::pow(10.0, lu);  // store u in linear space
+            Cs[k] = cs;
+        }
+    }
 
-            size_t i = itRho->second;
-            size_t j = itU->second;
+    void
+    setTables(std::vector<double> P, std::vector<double> U, std::vector<double> Cs) {
+        PTable  = EOSTable(std::move(P), logRhoGrid, logUGrid);
+        UTable  = EOSTable(std::move(U), logRhoGrid, logUGrid);
+        CsTable = EOSTable(std::move(Cs), logRhoGrid, logUGrid);
+    }
 
-            PTableData[i][j]  = P;
-            UTableData[i][j]  = std::pow(10.0, logU);  // store u in linear space
-            CsTableData[i][j] = cs;
-        }
+    // P, u and cs as read-only views of a binary table file
+    void
+    mapTable(const std::string& filename) {
+        EOSTableFile file(filename);
+        if (file.numTables() != 3)
+            throw std::runtime_error("HelmholtzEOS: " + filename + " should hold P, u and cs tables");
+        logRhoGrid = file.getXGrid();
+        logUGrid   = file.getYGrid();
+        PTable  = file.table(0);
+        UTable  = file.table(1);
+        CsTable = file.table(2);
+    }
 
-        // Assign to EOSTable members
-        PTable  = EOSTable(std::move(PTableData), logRhoGrid, logUGrid);
-        UTable  = EOSTable(std::move(UTableData), logRhoGrid, logUGrid);
-        CsTable = EOSTable(std::move(CsTableData), logRhoGrid, logUGrid);
+    static void
+    LogState(double* logRho, double* logU, const double* density, const double* internalEnergy, const int n) {
+        #pragma omp parallel for simd
+        for (int i = 0; i < n; ++i) {
+            logRho[i] = std::log10(density[i]);
+            logU[i]   = std::log10(internalEnergy[i]);
+        }
     }
 
     void 
-    computeHelmholtzApprox(double rho, double u, double& P, double& cs) {
+    computeHelmholtzApprox(double rho, double u, double& P, double& cs) const {
         const double kB = constants.kB();            // erg/K
         const double mH = constants.protonMass();    // g
         const double mu = 0.6;                       // mean molecular weight
@@ -123,7 +143,13 @@ public:
         if (fp) {
             std::fclose(fp);
             std::cout << "Using table file: " << tableFile << std::endl;
-            loadTable(tableFile);
+            if (EOSTableFile::isBinary(tableFile))
+                mapTable(tableFile);
+            else {
+                std::vector<double> P, U, Cs;
+                readTextTable(tableFile, logRhoGrid, logUGrid, P, U, Cs);
+                setTables(std::move(P), std::move(U), std::move(Cs));
+            }
         } else {
             std::cout << "Generating table file: " << tableFile << std::endl;
             generateTable();
@@ -226,57 +252,98 @@ public:
     }
 
 
+    virtual void
+    setPressure(double* pressure, const double* density, const double* internalEnergy, const int n) const override {
+        std::vector<double> logRho(n), logU(n);
+        LogState(logRho.data(), logU.data(), density, internalEnergy, n);
+        PTable.interpolate(pressure, logRho.data(), logU.data(), n);
+    }
+
+    virtual void
+    setSoundSpeed(double* soundSpeed, const double* density, const double* internalEnergy, const int n) const override {
+        std::vector<double> logRho(n), logU(n);
+        LogState(logRho.data(), logU.data(), density, internalEnergy, n);
+        CsTable.interpolate(soundSpeed, logRho.data(), logU.data(), n);
+    }
+
+    // the three tables share their axes, so each state is bracketed once for P and cs
+    virtual void
+    setThermodynamicState(double* pressure, double* soundSpeed, double* temperature, double* gamma, double* cv,
+                          const double* density, const double* internalEnergy, const int n) const override {
+        constexpr double mu = 0.6;                    // mean molecular weight
+        const double Tfactor = (2.0 / 3.0) * (mu * constants.protonMass() / constants.kB());
+
+        #pragma omp parallel for
+        for (int i = 0; i < n; ++i) {
+            const EOSTable::Stencil s = PTable.locate(std::log10(density[i]), std::log10(internalEnergy[i]));
+            const double P  = PTable.interpolate(s);
+            const double cs = CsTable.interpolate(s);
+            pressure[i]   = P;
+            soundSpeed[i] = cs;
+            if (temperature) temperature[i] = Tfactor * internalEnergy[i];
+            if (gamma)       gamma[i] = (P > 0.0 ? density[i] * cs * cs / P : 0.0);
+            if (cv)          cv[i] = 1.0 / Tfactor;
+        }
+    }
+
+    using EquationOfState::setThermodynamicState;
+    using EquationOfState::setPressure;
+    using EquationOfState::setSoundSpeed;
+
+    // "bilinear" or "monotoneCubic"
+    void
+    setInterpolation(const std::string& method) {
+        EOSTable::Interpolation mode;
+        if (method == "bilinear")           mode = EOSTable::Interpolation::Bilinear;
+        else if (method == "monotoneCubic") mode = EOSTable::Interpolation::MonotoneCubic;
+        else throw std::invalid_argument("HelmholtzEOS: interpolation must be bilinear or monotoneCubic");
+        PTable.setInterpolation(mode);
+        UTable.setInterpolation(mode);
+        CsTable.setInterpolation(mode);
+    }
+
+    std::string
+    getInterpolation() const {
+        return (PTable.getInterpolation() == EOSTable::Interpolation::Bilinear ? "bilinear" : "monotoneCubic");
+    }
+
     virtual std::string 
     name() const override {
         return "HelmholtzEOS";
     }
 
+    // tabulate the approximation over log rho in [-2, 10] and log u in [-2, 16], in
+    // parallel, and write it to tableFile in the binary format
     void 
     generateTable() {
-        // Define log-spaced rho and u values
         logRhoGrid = Lin::linspace(-2, 10, 300);  // log10(rho) from 1e-2 to 1e10
         logUGrid   = Lin::linspace(-2, 16, 300);  // log10(u) from 1e-2 to 1e16
 
-        std::vector<std::vector<double>> PTableData;
-        std::vector<std::vector<double>> UTableData;
-        std::vector<std::vector<double>> CsTableData;
-
-        // Resize tables
-        PTableData.resize(logRhoGrid.size(), std::vector<double>(logUGrid.size()));
-        UTableData = PTableData;
-        CsTableData = PTableData;
-
-        for (size_t i = 0; i < logRhoGrid.size(); ++i) {
-            for (size_t j = 0; j < logUGrid.size(); ++j) {
-                double rho = std::pow(10.0, logRhoGrid[i]);
-                double u   = std::pow(10.0, logUGrid[j]);
-
-                double P, cs;
-                computeHelmholtzApprox(rho, u, P, cs);
-
-                PTableData[i][j]  = P;
-                UTableData[i][j]  = u;
-                CsTableData[i][j] = cs;
+        const int nRho = logRhoGrid.size();
+        const int nU   = logUGrid.size();
+        std::vector<double> PData(nRho * nU), UData(nRho * nU), CsData(nRho * nU);
+
+        #pragma omp parallel for collapse(2) schedule(dynamic, 64)
+        for (int i = 0; i < nRho; ++i) {
+            for (int j = 0; j < nU; ++j) {
+                const double rho = std::pow(10.0, logRhoGrid[i]);
+                const double u   = std::pow(10.0, logUGrid[j]);
+                const int k = i * nU + j;
+                computeHelmholtzApprox(rho, u, PData[k], CsData[k]);
+                UData[k] = u;
             }
         }
 
-        // Write to file using C stdio
-        FILE* fp = std::fopen(tableFile.c_str(), "w");
-        if (!fp) throw std::runtime_error("Could not open file for writing: " + tableFile);
-
-        for (size_t i = 0; i < logRhoGrid.size(); ++i) {
-            for (size_t j = 0; j < logUGrid.size(); ++j) {
-                std::fprintf(fp, "%.10e %.10e %.10e %.10e\n",
-                            logRhoGrid[i], logUGrid[j],
-                            PTableData[i][j], CsTableData[i][j]);
-            }
-        }
-
-        std::fclose(fp);
+        EOSTableFile::write(tableFile, logRhoGrid, logUGrid, {PData.data(), UData.data(), CsData.data()});
+        setTables(std::move(PData), std::move(UData), std::move(CsData));
+    }
 
-        PTable  = EOSTable(std::move(PTableData), logRhoGrid, logUGrid);
-        UTable  = EOSTable(std::move(UTableData), logRhoGrid, logUGrid);
-        CsTable = EOSTable(std::move(CsTableData), logRhoGrid, logUGrid);
+    // import a text table of "logRho logU P cs" rows into the binary format
+    static void
+    convertTable(const std::string& textFile, const std::string& binaryFile) {
+        std::vector<double> logRho, logU, P, U, Cs;
+        readTextTable(textFile, logRho, logU, P, U, Cs);
+        EOSTableFile::write(binaryFile, logRho, logU, {P.data(), U.data(), Cs.data()});
     }
 
 };
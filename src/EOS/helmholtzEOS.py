@@ -6,6 +6,16 @@ class HelmholtzEOS(EquationOfState):
     def pyinit(self,tableFile="std::string&",constants="PhysicalConstants&"):
         return
 
+    @PYB11static
+    def convertTable(self,
+                     textFile = "const std::string&",
+                     binaryFile = "const std::string&"):
+        "Import a text table of logRho logU P cs rows into the binary table format"
+        return "void"
+
+    interpolation = PYB11property("std::string", getter="getInterpolation", setter="setInterpolation",
+                                  doc="Table interpolation, bilinear or monotoneCubic.")
+
 #-------------------------------------------------------------------------------
 # Add the virtual interface
 #-------------------------------------------------------------------------------
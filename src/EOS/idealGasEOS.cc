@@ -16,51 +16,29 @@ public:
     // Method to compute pressure given density and internal energy
     virtual void 
     setPressure(Field<double>* pressure, Field<double>* density, Field<double>* internalEnergy) const override {   
-        for(int i=0;i<pressure->size();++i)
-            pressure->setValue(i,(gamma - 1.0) * density->getValue(i) * internalEnergy->getValue(i));
+        setPressure(data(pressure), data(density), data(internalEnergy), pressure->size());
     }
 
     // Method to compute internal energy given density and pressure
     virtual void 
     setInternalEnergy(Field<double>* internalEnergy, Field<double>* density, Field<double>* pressure) const override {
-        for (int i = 0; i < internalEnergy->size(); ++i) {
-            const double rho = density->getValue(i);
-            const double P = pressure->getValue(i);
-            internalEnergy->setValue(i, P / ((gamma - 1.0) * rho));
-        }
+        setInternalEnergy(data(internalEnergy), data(density), data(pressure), internalEnergy->size());
     }
 
     // Method to compute sound speed given density and pressure
     virtual void 
     setSoundSpeed(Field<double>* soundSpeed, Field<double>* density, Field<double>* internalEnergy) const override {
-        for(int i=0;i<soundSpeed->size();++i)
-            soundSpeed->setValue(i,std::sqrt(gamma * (gamma - 1.0) * internalEnergy->getValue(i)));
+        setSoundSpeed(data(soundSpeed), data(density), data(internalEnergy), soundSpeed->size());
     }
 
     virtual void 
     setTemperature(Field<double>* temperature, Field<double>* density, Field<double>* internalEnergy) const override {
-        const double kB = constants.kB();
-        const double mu = 1.0;  // mean molecular weight (placeholder)
-        const double mH = constants.protonMass();
-
-        for (int i = 0; i < temperature->size(); ++i) {
-            double rho = density->getValue(i);
-            double u = internalEnergy->getValue(i);
-            double T = (gamma - 1.0) * u * mu * mH / kB;
-            temperature->setValue(i, T);
-        }
+        setTemperature(data(temperature), data(density), data(internalEnergy), temperature->size());
     }
 
     virtual void 
     setInternalEnergyFromTemperature(Field<double>* internalEnergy, Field<double>* density, Field<double>* temperature) const override {
-        const double kB = constants.kB();
-        const double mu = 1.0;
-        const double mH = constants.protonMass();
-
-        for (int i = 0; i < internalEnergy->size(); ++i) {
-            double T = temperature->getValue(i);
-            internalEnergy->setValue(i, kB * T / ((gamma - 1.0) * mu * mH));
-        }
+        setInternalEnergyFromTemperature(data(internalEnergy), data(density), data(temperature), internalEnergy->size());
     }
 
     virtual void 
@@ -96,6 +74,67 @@ public:
         *internalEnergy = (*temperature) * kB / ((gamma - 1.0) * mu * mH);
     }
 
+    virtual void
+    setPressure(double* pressure, const double* density, const double* internalEnergy, const int n) const override {
+        #pragma omp parallel for simd
+        for (int i = 0; i < n; ++i)
+            pressure[i] = (gamma - 1.0) * density[i] * internalEnergy[i];
+    }
+
+    virtual void
+    setInternalEnergy(double* internalEnergy, const double* density, const double* pressure, const int n) const override {
+        #pragma omp parallel for simd
+        for (int i = 0; i < n; ++i)
+            internalEnergy[i] = pressure[i] / ((gamma - 1.0) * density[i]);
+    }
+
+    virtual void
+    setSoundSpeed(double* soundSpeed, const double* density, const double* internalEnergy, const int n) const override {
+        #pragma omp parallel for simd
+        for (int i = 0; i < n; ++i)
+            soundSpeed[i] = std::sqrt(gamma * (gamma - 1.0) * internalEnergy[i]);
+    }
+
+    virtual void
+    setTemperature(double* temperature, const double* density, const double* internalEnergy, const int n) const override {
+        const double mu = 1.0;  // mean molecular weight (placeholder)
+        const double factor = (gamma - 1.0) * mu * constants.protonMass() / constants.kB();
+        #pragma omp parallel for simd
+        for (int i = 0; i < n; ++i)
+            temperature[i] = factor * internalEnergy[i];
+    }
+
+    virtual void
+    setInternalEnergyFromTemperature(double* internalEnergy, const double* density, const double* temperature, const int n) const override {
+        const double mu = 1.0;
+        const double factor = constants.kB() / ((gamma - 1.0) * mu * constants.protonMass());
+        #pragma omp parallel for simd
+        for (int i = 0; i < n; ++i)
+            internalEnergy[i] = factor * temperature[i];
+    }
+
+    virtual void
+    setThermodynamicState(double* pressure, double* soundSpeed, double* temperature, double* gammaOut, double* cv,
+                          const double* density, const double* internalEnergy, const int n) const override {
+        const double mu = 1.0;
+        const double Tfactor = (gamma - 1.0) * mu * constants.protonMass() / constants.kB();
+        #pragma omp parallel for simd
+        for (int i = 0; i < n; ++i) {
+            pressure[i]   = (gamma - 1.0) * density[i] * internalEnergy[i];
+            soundSpeed[i] = std::sqrt(gamma * (gamma - 1.0) * internalEnergy[i]);
+        }
+        if (temperature) {
+            #pragma omp parallel for simd
+            for (int i = 0; i < n; ++i)
+                temperature[i] = Tfactor * internalEnergy[i];
+        }
+        if (gammaOut)
+            std::fill(gammaOut, gammaOut + n, gamma);
+        if (cv)
+            std::fill(cv, cv + n, 1.0 / Tfactor);
+    }
+
+    using EquationOfState::setThermodynamicState;
 
     double getGamma() const{ return gamma; }
 
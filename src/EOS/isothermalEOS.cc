@@ -15,20 +15,16 @@ public:
           cs(soundSpeed) {}
 
     // --- Field versions ---
-    virtual void setPressure(Field<double>* pressure, Field<double>* density, Field<double>*) const override {
-        for (int i = 0; i < pressure->size(); ++i) {
-            pressure->setValue(i, (*density)[i] * cs * cs);
-        }
+    virtual void setPressure(Field<double>* pressure, Field<double>* density, Field<double>* internalEnergy) const override {
+        setPressure(data(pressure), data(density), data(internalEnergy), pressure->size());
     }
 
     virtual void setInternalEnergy(Field<double>* internalEnergy, Field<double>*, Field<double>*) const override {
         throw std::runtime_error("IsothermalEOS does not define internal energy.");
     }
 
-    virtual void setSoundSpeed(Field<double>* soundSpeed, Field<double>*, Field<double>*) const override {
-        for (int i = 0; i < soundSpeed->size(); ++i) {
-            soundSpeed->setValue(i, cs);
-        }
+    virtual void setSoundSpeed(Field<double>* soundSpeed, Field<double>* density, Field<double>* internalEnergy) const override {
+        setSoundSpeed(data(soundSpeed), data(density), data(internalEnergy), soundSpeed->size());
     }
 
     virtual void setTemperature(Field<double>*, Field<double>*, Field<double>*) const override {
@@ -60,6 +56,31 @@ public:
         throw std::runtime_error("IsothermalEOS does not define internal energy from temperature.");
     }
 
+    // --- Batched versions ---
+    virtual void setPressure(double* pressure, const double* density, const double*, const int n) const override {
+        #pragma omp parallel for simd
+        for (int i = 0; i < n; ++i)
+            pressure[i] = density[i] * cs * cs;
+    }
+
+    virtual void setInternalEnergy(double*, const double*, const double*, const int) const override {
+        throw std::runtime_error("IsothermalEOS does not define internal energy.");
+    }
+
+    virtual void setSoundSpeed(double* soundSpeed, const double*, const double*, const int n) const override {
+        #pragma omp parallel for simd
+        for (int i = 0; i < n; ++i)
+            soundSpeed[i] = cs;
+    }
+
+    virtual void setTemperature(double*, const double*, const double*, const int) const override {
+        throw std::runtime_error("IsothermalEOS does not define temperature.");
+    }
+
+    virtual void setInternalEnergyFromTemperature(double*, const double*, const double*, const int) const override {
+        throw std::runtime_error("IsothermalEOS does not define internal energy from temperature.");
+    }
+
     // --- Accessors ---
     virtual std::string name() const override {
         return "IsothermalEOS";
@@ -23,48 +23,17 @@ public:
 
     virtual void 
     setPressure(Field<double>* pressure, Field<double>* density, Field<double>* internalEnergy) const override {
-        for (int i = 0; i < density->size(); ++i) {
-            double rho = density->getValue(i);
-            double e   = internalEnergy->getValue(i);
-            double eta = (rho / rho0) - 1.0;
-
-            double denom = 1.0 - S * eta;
-            double Pref = (rho0 * C0 * C0 * eta * (1.0 + 0.5 * (1.0 - S) * eta)) / (denom * denom);
-
-            double P = Pref + Gamma0 * rho * e;
-            pressure->setValue(i, P);
-        }
+        setPressure(data(pressure), data(density), data(internalEnergy), density->size());
     }
 
     virtual void 
     setInternalEnergy(Field<double>* internalEnergy, Field<double>* density, Field<double>* pressure) const override {
-        for (int i = 0; i < density->size(); ++i) {
-            double rho = density->getValue(i);
-            double P   = pressure->getValue(i);
-            double eta = (rho / rho0) - 1.0;
-
-            double denom = 1.0 - S * eta;
-            double Pref = (rho0 * C0 * C0 * eta * (1.0 + 0.5 * (1.0 - S) * eta)) / (denom * denom);
-
-            double e = (P - Pref) / (Gamma0 * rho);
-            internalEnergy->setValue(i, e);
-        }
+        setInternalEnergy(data(internalEnergy), data(density), data(pressure), density->size());
     }
 
     virtual void 
     setSoundSpeed(Field<double>* soundSpeed, Field<double>* density, Field<double>* internalEnergy) const override {
-        for (int i = 0; i < density->size(); ++i) {
-            double rho = density->getValue(i);
-            double e   = internalEnergy->getValue(i);
-            double eta = (rho / rho0) - 1.0;
-
-            double denom = 1.0 - S * eta;
-            double Pref = (rho0 * C0 * C0 * eta * (1.0 + 0.5 * (1.0 - S) * eta)) / (denom * denom);
-            double dPref_drho = (C0 * C0 / rho0) * (1 + eta) * (1 + 0.5 * (1 - S) * eta) / (denom * denom * denom);
-
-            double cs2 = dPref_drho + Gamma0 * e;
-            soundSpeed->setValue(i, std::sqrt(std::max(cs2, 0.0)));
-        }
+        setSoundSpeed(data(soundSpeed), data(density), data(internalEnergy), density->size());
     }
 
     virtual void 
@@ -122,6 +91,53 @@ public:
         throw std::runtime_error("Mie-GrüneisenEOS does not define internal energy from temperature.");
     }
 
+    // Batched methods
+    virtual void
+    setPressure(double* pressure, const double* density, const double* internalEnergy, const int n) const override {
+        #pragma omp parallel for simd
+        for (int i = 0; i < n; ++i) {
+            const double rho = density[i];
+            const double eta = (rho / rho0) - 1.0;
+            const double denom = 1.0 - S * eta;
+            const double Pref = (rho0 * C0 * C0 * eta * (1.0 + 0.5 * (1.0 - S) * eta)) / (denom * denom);
+            pressure[i] = Pref + Gamma0 * rho * internalEnergy[i];
+        }
+    }
+
+    virtual void
+    setInternalEnergy(double* internalEnergy, const double* density, const double* pressure, const int n) const override {
+        #pragma omp parallel for simd
+        for (int i = 0; i < n; ++i) {
+            const double rho = density[i];
+            const double eta = (rho / rho0) - 1.0;
+            const double denom = 1.0 - S * eta;
+            const double Pref = (rho0 * C0 * C0 * eta * (1.0 + 0.5 * (1.0 - S) * eta)) / (denom * denom);
+            internalEnergy[i] = (pressure[i] - Pref) / (Gamma0 * rho);
+        }
+    }
+
+    virtual void
+    setSoundSpeed(double* soundSpeed, const double* density, const double* internalEnergy, const int n) const override {
+        #pragma omp parallel for simd
+        for (int i = 0; i < n; ++i) {
+            const double eta = (density[i] / rho0) - 1.0;
+            const double denom = 1.0 - S * eta;
+            const double dPref_drho = (C0 * C0 / rho0) * (1 + eta) * (1 + 0.5 * (1 - S) * eta) / (denom * denom * denom);
+            const double cs2 = dPref_drho + Gamma0 * internalEnergy[i];
+            soundSpeed[i] = std::sqrt(std::max(cs2, 0.0));
+        }
+    }
+
+    virtual void
+    setTemperature(double* temperature, const double* density, const double* internalEnergy, const int n) const override {
+        throw std::runtime_error("Mie-GrüneisenEOS does not define temperature.");
+    }
+
+    virtual void
+    setInternalEnergyFromTemperature(double* internalEnergy, const double* density, const double* temperature, const int n) const override {
+        throw std::runtime_error("Mie-GrüneisenEOS does not define internal energy from temperature.");
+    }
+
     virtual std::string 
     name() const override {
         return "Mie-GrüneisenEOS";
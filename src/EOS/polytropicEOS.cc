@@ -22,10 +22,7 @@ public:
     // --- Field versions ---
     virtual void 
     setPressure(Field<double>* pressure, Field<double>* density, Field<double>* internalEnergy) const override {
-        for (int i = 0; i < pressure->size(); ++i) {
-            const double rho = density->getValue(i);
-            pressure->setValue(i, kappa * std::pow(rho, gamma));
-        }
+        setPressure(data(pressure), data(density), data(internalEnergy), pressure->size());
     }
 
     virtual void 
@@ -35,10 +32,7 @@ public:
 
     virtual void 
     setSoundSpeed(Field<double>* soundSpeed, Field<double>* density, Field<double>* internalEnergy) const override {
-        for (int i = 0; i < soundSpeed->size(); ++i) {
-            const double rho = density->getValue(i);
-            soundSpeed->setValue(i, std::sqrt(gamma * kappa * std::pow(rho, gamma - 1.0)));
-        }
+        setSoundSpeed(data(soundSpeed), data(density), data(internalEnergy), soundSpeed->size());
     }
 
     virtual void 
@@ -77,6 +71,36 @@ public:
         throw std::runtime_error("PolytropicEOS does not define internal energy from temperature.");
     }
 
+    // --- Batched versions ---
+    virtual void
+    setPressure(double* pressure, const double* density, const double* internalEnergy, const int n) const override {
+        #pragma omp parallel for simd
+        for (int i = 0; i < n; ++i)
+            pressure[i] = kappa * std::pow(density[i], gamma);
+    }
+
+    virtual void
+    setInternalEnergy(double* internalEnergy, const double* density, const double* pressure, const int n) const override {
+        throw std::runtime_error("PolytropicEOS does not support setting internal energy from pressure and density.");
+    }
+
+    virtual void
+    setSoundSpeed(double* soundSpeed, const double* density, const double* internalEnergy, const int n) const override {
+        #pragma omp parallel for simd
+        for (int i = 0; i < n; ++i)
+            soundSpeed[i] = std::sqrt(gamma * kappa * std::pow(density[i], gamma - 1.0));
+    }
+
+    virtual void
+    setTemperature(double* temperature, const double* density, const double* internalEnergy, const int n) const override {
+        throw std::runtime_error("PolytropicEOS does not define temperature.");
+    }
+
+    virtual void
+    setInternalEnergyFromTemperature(double* internalEnergy, const double* density, const double* temperature, const int n) const override {
+        throw std::runtime_error("PolytropicEOS does not define internal energy from temperature.");
+    }
+
     // --- Accessors ---
     double getGamma() const { return gamma; }
     double getKappa() const { return kappa; }
@@ -0,0 +1,282 @@
+// Copyright (C) 2025  Cody Raskin
+
+#include "equationOfState.hh"
+#include "eosTable.hh"
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+// Wraps any EquationOfState in tables of P, cs and (if the model has one) T on a grid
+// in (log rho, log u), so a model with exp/pow-heavy closed forms like Tillotson costs
+// the same flat amount per cell as an ideal gas. The grid is sampled once at
+// construction through the wrapped model's batched methods; states off the grid, and
+// the inversions to internal energy, are passed straight to the wrapped model.
+//
+// The worst relative errors at the cell centers, where interpolation is furthest from
+// the samples, are measured at construction as an estimate of the tabulation error.
+class TabulatedEOS : public EquationOfState {
+private:
+    EquationOfState* eos;
+    std::vector<double> logRhoGrid, logUGrid;
+    EOSTable PTable, CsTable, TTable;
+    bool hasTemperature = true;
+    double pressureError = 0.0, soundSpeedError = 0.0, temperatureError = 0.0;
+
+    // log rho and log u of a state, if it lies on the table
+    inline bool
+    onTable(double rho, double u, double& logRho, double& logU) const {
+        if (!(rho > 0.0 && u > 0.0)) return false;
+        logRho = std::log10(rho);
+        logU   = std::log10(u);
+        return logRho >= logRhoGrid.front() && logRho <= logRhoGrid.back() &&
+               logU >= logUGrid.front() && logU <= logUGrid.back();
+    }
+
+    // P, cs and T at every (rho, u) pair of the flattened grid, from the wrapped model
+    void
+    Sample(const std::vector<double>& rho, const std::vector<double>& u,
+           std::vector<double>& P, std::vector<double>& cs, std::vector<double>& T) {
+        const int n = rho.size();
+        P.resize(n);
+        cs.resize(n);
+        T.resize(n);
+        eos->setPressure(P.data(), rho.data(), u.data(), n);
+        eos->setSoundSpeed(cs.data(), rho.data(), u.data(), n);
+        if (hasTemperature) {
+            try {
+                eos->setTemperature(T.data(), rho.data(), u.data(), n);
+            } catch (const std::runtime_error&) {
+                hasTemperature = false;
+            }
+        }
+    }
+
+    // one quantity at one state: interpolated from its own table on the grid, or from the
+    // wrapped model's scalar method (fallback) off it
+    template <typename Fallback>
+    inline double
+    LookUp(const EOSTable& table, double rho, double u, Fallback&& fallback) const {
+        double logRho, logU;
+        if (onTable(rho, u, logRho, logU))
+            return table.interpolate(table.locate(logRho, logU));
+        double value;
+        fallback(&value, &rho, &u);
+        return value;
+    }
+
+    // the same for n states, leaving the other tables alone
+    template <typename Fallback>
+    void
+    LookUp(const EOSTable& table, double* out, const double* density, const double* internalEnergy,
+           const int n, Fallback&& fallback) const {
+        #pragma omp parallel for
+        for (int k = 0; k < n; ++k)
+            out[k] = LookUp(table, density[k], internalEnergy[k], fallback);
+    }
+
+    static double
+    MaxRelativeError(const std::vector<double>& approx, const std::vector<double>& exact) {
+        double scale = 0.0;
+        for (double v : exact) scale = std::max(scale, std::abs(v));
+        const double floor = 1e-12 * scale;   // don't judge values that cross zero by their size there
+        double err = 0.0;
+        #pragma omp parallel for reduction(max:err)
+        for (int k = 0; k < (int)exact.size(); ++k)
+            err = std::max(err, std::abs(approx[k] - exact[k]) / std::max(std::abs(exact[k]), floor));
+        return err;
+    }
+
+    void
+    EstimateError() {
+        const int nRho = logRhoGrid.size() - 1, nU = logUGrid.size() - 1;
+        std::vector<double> rho(nRho * nU), u(nRho * nU), P, cs, T;
+        for (int i = 0; i < nRho; ++i)
+            for (int j = 0; j < nU; ++j) {
+                rho[i * nU + j] = std::pow(10.0, 0.5 * (logRhoGrid[i] + logRhoGrid[i + 1]));
+                u[i * nU + j]   = std::pow(10.0, 0.5 * (logUGrid[j] + logUGrid[j + 1]));
+            }
+        Sample(rho, u, P, cs, T);
+
+        std::vector<double> Pt(rho.size()), cst(rho.size()), Tt(rho.size());
+        #pragma omp parallel for
+        for (int k = 0; k < (int)rho.size(); ++k) {
+            const EOSTable::Stencil s = PTable.locate(std::log10(rho[k]), std::log10(u[k]));
+            Pt[k]  = PTable.interpolate(s);
+            cst[k] = CsTable.interpolate(s);
+            if (hasTemperature) Tt[k] = TTable.interpolate(s);
+        }
+        pressureError    = MaxRelativeError(Pt, P);
+        soundSpeedError  = MaxRelativeError(cst, cs);
+        temperatureError = (hasTemperature ? MaxRelativeError(Tt, T) : 0.0);
+    }
+
+public:
+    // interpolation is "bilinear" or "monotoneCubic"
+    TabulatedEOS(EquationOfState* eos, PhysicalConstants& constants,
+                 double logRhoMin, double logRhoMax, int nRho,
+                 double logUMin, double logUMax, int nU,
+                 std::string interpolation) :
+        EquationOfState(constants), eos(eos) {
+        if (nRho < 2 || nU < 2 || logRhoMax <= logRhoMin || logUMax <= logUMin)
+            throw std::invalid_argument("TabulatedEOS: need at least two points on increasing axes");
+        EOSTable::Interpolation mode;
+        if (interpolation == "bilinear")           mode = EOSTable::Interpolation::Bilinear;
+        else if (interpolation == "monotoneCubic") mode = EOSTable::Interpolation::MonotoneCubic;
+        else throw std::invalid_argument("TabulatedEOS: interpolation must be bilinear or monotoneCubic");
+
+        logRhoGrid = Lin::linspace(logRhoMin, logRhoMax, nRho);
+        logUGrid   = Lin::linspace(logUMin, logUMax, nU);
+
+        std::vector<double> rho(nRho * nU), u(nRho * nU), P, cs, T;
+        #pragma omp parallel for
+        for (int i = 0; i < nRho; ++i)
+            for (int j = 0; j < nU; ++j) {
+                rho[i * nU + j] = std::pow(10.0, logRhoGrid[i]);
+                u[i * nU + j]   = std::pow(10.0, logUGrid[j]);
+            }
+        Sample(rho, u, P, cs, T);
+
+        PTable  = EOSTable(std::move(P), logRhoGrid, logUGrid);
+        CsTable = EOSTable(std::move(cs), logRhoGrid, logUGrid);
+        if (hasTemperature)
+            TTable = EOSTable(std::move(T), logRhoGrid, logUGrid);
+        PTable.setInterpolation(mode);
+        CsTable.setInterpolation(mode);
+        TTable.setInterpolation(mode);
+
+        EstimateError();
+    }
+
+    TabulatedEOS(EquationOfState* eos, PhysicalConstants& constants,
+                 double logRhoMin, double logRhoMax, int nRho,
+                 double logUMin, double logUMax, int nU) :
+        TabulatedEOS(eos, constants, logRhoMin, logRhoMax, nRho, logUMin, logUMax, nU, "monotoneCubic") {}
+
+    // --- Field versions ---
+    virtual void
+    setPressure(Field<double>* pressure, Field<double>* density, Field<double>* internalEnergy) const override {
+        setPressure(data(pressure), data(density), data(internalEnergy), pressure->size());
+    }
+
+    virtual void
+    setInternalEnergy(Field<double>* internalEnergy, Field<double>* density, Field<double>* pressure) const override {
+        eos->setInternalEnergy(internalEnergy, density, pressure);
+    }
+
+    virtual void
+    setSoundSpeed(Field<double>* soundSpeed, Field<double>* density, Field<double>* internalEnergy) const override {
+        setSoundSpeed(data(soundSpeed), data(density), data(internalEnergy), soundSpeed->size());
+    }
+
+    virtual void
+    setTemperature(Field<double>* temperature, Field<double>* density, Field<double>* internalEnergy) const override {
+        setTemperature(data(temperature), data(density), data(internalEnergy), temperature->size());
+    }
+
+    virtual void
+    setInternalEnergyFromTemperature(Field<double>* internalEnergy, Field<double>* density, Field<double>* temperature) const override {
+        eos->setInternalEnergyFromTemperature(internalEnergy, density, temperature);
+    }
+
+    // --- Scalar versions ---
+    virtual void
+    setPressure(double* pressure, double* density, double* internalEnergy) const override {
+        *pressure = LookUp(PTable, *density, *internalEnergy,
+                           [this](double* P, double* rho, double* u) { eos->setPressure(P, rho, u); });
+    }
+
+    virtual void
+    setInternalEnergy(double* internalEnergy, double* density, double* pressure) const override {
+        eos->setInternalEnergy(internalEnergy, density, pressure);
+    }
+
+    virtual void
+    setSoundSpeed(double* soundSpeed, double* density, double* internalEnergy) const override {
+        *soundSpeed = LookUp(CsTable, *density, *internalEnergy,
+                             [this](double* cs, double* rho, double* u) { eos->setSoundSpeed(cs, rho, u); });
+    }
+
+    virtual void
+    setTemperature(double* temperature, double* density, double* internalEnergy) const override {
+        if (!hasTemperature)
+            throw std::runtime_error("TabulatedEOS: " + eos->name() + " does not define temperature.");
+        *temperature = LookUp(TTable, *density, *internalEnergy,
+                              [this](double* T, double* rho, double* u) { eos->setTemperature(T, rho, u); });
+    }
+
+    virtual void
+    setInternalEnergyFromTemperature(double* internalEnergy, double* density, double* temperature) const override {
+        eos->setInternalEnergyFromTemperature(internalEnergy, density, temperature);
+    }
+
+    // --- Batched versions ---
+    virtual void
+    setPressure(double* pressure, const double* density, const double* internalEnergy, const int n) const override {
+        LookUp(PTable, pressure, density, internalEnergy, n,
+               [this](double* P, double* rho, double* u) { eos->setPressure(P, rho, u); });
+    }
+
+    virtual void
+    setInternalEnergy(double* internalEnergy, const double* density, const double* pressure, const int n) const override {
+        eos->setInternalEnergy(internalEnergy, density, pressure, n);
+    }
+
+    virtual void
+    setSoundSpeed(double* soundSpeed, const double* density, const double* internalEnergy, const int n) const override {
+        LookUp(CsTable, soundSpeed, density, internalEnergy, n,
+               [this](double* cs, double* rho, double* u) { eos->setSoundSpeed(cs, rho, u); });
+    }
+
+    virtual void
+    setTemperature(double* temperature, const double* density, const double* internalEnergy, const int n) const override {
+        if (!hasTemperature)
+            throw std::runtime_error("TabulatedEOS: " + eos->name() + " does not define temperature.");
+        LookUp(TTable, temperature, density, internalEnergy, n,
+               [this](double* T, double* rho, double* u) { eos->setTemperature(T, rho, u); });
+    }
+
+    virtual void
+    setInternalEnergyFromTemperature(double* internalEnergy, const double* density, const double* temperature, const int n) const override {
+        eos->setInternalEnergyFromTemperature(internalEnergy, density, temperature, n);
+    }
+
+    // any of the outputs may be null here; cv falls back to the wrapped model
+    virtual void
+    setThermodynamicState(double* pressure, double* soundSpeed, double* temperature, double* gamma, double* cv,
+                          const double* density, const double* internalEnergy, const int n) const override {
+        if (temperature && !hasTemperature)
+            throw std::runtime_error("TabulatedEOS: " + eos->name() + " does not define temperature.");
+        #pragma omp parallel for
+        for (int k = 0; k < n; ++k) {
+            double rho = density[k], u = internalEnergy[k];
+            double P, cs, logRho, logU;
+            if (onTable(rho, u, logRho, logU)) {
+                const EOSTable::Stencil s = PTable.locate(logRho, logU);
+                P  = PTable.interpolate(s);
+                cs = CsTable.interpolate(s);
+                if (temperature) temperature[k] = TTable.interpolate(s);
+            } else {
+                eos->setPressure(&P, &rho, &u);
+                eos->setSoundSpeed(&cs, &rho, &u);
+                if (temperature) eos->setTemperature(&temperature[k], &rho, &u);
+            }
+            if (pressure)   pressure[k] = P;
+            if (soundSpeed) soundSpeed[k] = cs;
+            if (gamma)      gamma[k] = (P > 0.0 ? rho * cs * cs / P : 0.0);
+        }
+        if (cv) {
+            std::vector<double> discard(n);
+            eos->setThermodynamicState(discard.data(), discard.data(), nullptr, nullptr, cv, density, internalEnergy, n);
+        }
+    }
+
+    using EquationOfState::setThermodynamicState;
+
+    inline EquationOfState* getEOS() const { return eos; }
+    inline double getPressureError() const { return pressureError; }
+    inline double getSoundSpeedError() const { return soundSpeedError; }
+    inline double getTemperatureError() const { return temperatureError; }
+    inline bool definesTemperature() const { return hasTemperature; }
+
+    virtual std::string name() const override { return "TabulatedEOS(" + eos->name() + ")"; }
+};
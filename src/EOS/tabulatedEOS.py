@@ -0,0 +1,38 @@
+from PYB11Generator import *
+from equationOfState import *
+from EOSAbstractMethods import *
+
+class TabulatedEOS(EquationOfState):
+    def pyinit(self,
+               eos="EquationOfState*",
+               constants="PhysicalConstants&",
+               logRhoMin="double",
+               logRhoMax="double",
+               nRho="int",
+               logUMin="double",
+               logUMax="double",
+               nU="int"):
+        return
+
+    def pyinit1(self,
+                eos="EquationOfState*",
+                constants="PhysicalConstants&",
+                logRhoMin="double",
+                logRhoMax="double",
+                nRho="int",
+                logUMin="double",
+                logUMax="double",
+                nU="int",
+                interpolation="std::string"):
+        "interpolation is bilinear or monotoneCubic"
+        return
+
+    pressureError = PYB11property("double", getter="getPressureError", doc="Worst relative pressure error at the table's cell centers.")
+    soundSpeedError = PYB11property("double", getter="getSoundSpeedError", doc="Worst relative sound speed error at the table's cell centers.")
+    temperatureError = PYB11property("double", getter="getTemperatureError", doc="Worst relative temperature error at the table's cell centers.")
+    definesTemperature = PYB11property("bool", getter="definesTemperature", doc="Whether the wrapped model has a temperature.")
+
+#-------------------------------------------------------------------------------
+# Add the virtual interface
+#-------------------------------------------------------------------------------
+PYB11inject(EOSAbstractMethods, EquationOfState, pure_virtual=True)
@@ -51,9 +51,7 @@ public:
     // Field-based methods
     virtual void 
     setPressure(Field<double>* pressure, Field<double>* density, Field<double>* internalEnergy) const override {
-        for (int i = 0; i < density->size(); ++i) {
-            (*pressure)[i] = computePressure((*density)[i], (*internalEnergy)[i]);
-        }
+        setPressure(data(pressure), data(density), data(internalEnergy), density->size());
     }
 
     virtual void 
@@ -63,23 +61,7 @@ public:
 
     virtual void 
     setSoundSpeed(Field<double>* soundSpeed, Field<double>* density, Field<double>* internalEnergy) const override {
-        for (int i = 0; i < density->size(); ++i) {
-            const double rho = (*density)[i];
-            const double e   = (*internalEnergy)[i];
-
-            const double drho = 1e-4 * rho;
-            const double de = 1e-4 * e;
-
-            double P0 = computePressure(rho, e);
-            double Prho = computePressure(rho + drho, e);
-            double Pe = computePressure(rho, e + de);
-
-            double dPdrho = (Prho - P0) / drho;
-            double dPde = (Pe - P0) / de;
-
-            double cs2 = dPdrho + dPde * e / rho;
-            (*soundSpeed)[i] = std::sqrt(std::max(cs2, 0.0));
-        }
+        setSoundSpeed(data(soundSpeed), data(density), data(internalEnergy), density->size());
     }
 
     virtual void 
@@ -132,6 +114,75 @@ public:
         throw std::runtime_error("TillotsonEOS does not define internal energy from temperature.");
     }
 
+    // Batched methods
+    virtual void
+    setPressure(double* pressure, const double* density, const double* internalEnergy, const int n) const override {
+        #pragma omp parallel for simd
+        for (int i = 0; i < n; ++i)
+            pressure[i] = computePressure(density[i], internalEnergy[i]);
+    }
+
+    virtual void
+    setInternalEnergy(double*, const double*, const double*, const int) const override {
+        throw std::runtime_error("TillotsonEOS does not support inversion to internal energy.");
+    }
+
+    virtual void
+    setSoundSpeed(double* soundSpeed, const double* density, const double* internalEnergy, const int n) const override {
+        #pragma omp parallel for simd
+        for (int i = 0; i < n; ++i) {
+            const double rho = density[i];
+            const double e   = internalEnergy[i];
+
+            const double drho = 1e-4 * rho;
+            const double de = 1e-4 * e;
+
+            double P0 = computePressure(rho, e);
+            double dPdrho = (computePressure(rho + drho, e) - P0) / drho;
+            double dPde = (computePressure(rho, e + de) - P0) / de;
+
+            double cs2 = dPdrho + dPde * e / rho;
+            soundSpeed[i] = std::sqrt(std::max(cs2, 0.0));
+        }
+    }
+
+    // P comes for free from the sound speed's finite difference
+    virtual void
+    setThermodynamicState(double* pressure, double* soundSpeed, double* temperature, double* gamma, double* cv,
+                          const double* density, const double* internalEnergy, const int n) const override {
+        if (temperature || cv)
+            throw std::runtime_error("TillotsonEOS does not define temperature.");
+        #pragma omp parallel for simd
+        for (int i = 0; i < n; ++i) {
+            const double rho = density[i];
+            const double e   = internalEnergy[i];
+
+            const double drho = 1e-4 * rho;
+            const double de = 1e-4 * e;
+
+            double P0 = computePressure(rho, e);
+            double dPdrho = (computePressure(rho + drho, e) - P0) / drho;
+            double dPde = (computePressure(rho, e + de) - P0) / de;
+
+            double cs2 = std::max(dPdrho + dPde * e / rho, 0.0);
+            pressure[i] = P0;
+            soundSpeed[i] = std::sqrt(cs2);
+            if (gamma) gamma[i] = (P0 > 0.0 ? rho * cs2 / P0 : 0.0);
+        }
+    }
+
+    using EquationOfState::setThermodynamicState;
+
+    virtual void
+    setTemperature(double*, const double*, const double*, const int) const override {
+        throw std::runtime_error("TillotsonEOS does not define temperature.");
+    }
+
+    virtual void
+    setInternalEnergyFromTemperature(double*, const double*, const double*, const int) const override {
+        throw std::runtime_error("TillotsonEOS does not define internal energy from temperature.");
+    }
+
     virtual std::string 
     name() const override {
         return "TillotsonEOS";
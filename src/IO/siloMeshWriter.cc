@@ -71,6 +71,13 @@ SiloMeshWriter<dim>::writeFields(DBfile* dbfile) {
             continue;
         }
 
+        auto field_float = nodeList.getField<float>(field_name);
+        if (field_float) {
+            std::vector<float> field_data(field_float->getValues());
+            DBPutPointvar1(dbfile, field_name.c_str(), "pointmesh", field_data.data(), nodeList.size(), DB_FLOAT, nullptr);
+            continue;
+        }
+
         auto field_vector = nodeList.getField<Lin::Vector<dim>>(field_name);
         if (field_vector) {
             std::vector<float> field_data[dim];
@@ -72,6 +72,16 @@ VTKMeshWriter<dim>::writePointData(std::ofstream& outFile) {
             continue;
         }
 
+        auto field_float = nodeList->getField<float>(field_name);
+        if (field_float) {
+            outFile << "SCALARS " << field_name << " float\n";
+            outFile << "LOOKUP_TABLE default\n";
+            for (unsigned int i = 0; i < field_float->size(); ++i) {
+                outFile << field_float->getValue(i) << "\n";
+            }
+            continue;
+        }
+
         auto field_vector = nodeList->getField<Lin::Vector<dim>>(field_name);
         if (field_vector) {
             for (int d = 0; d < dim; ++d) {
@@ -2,9 +2,17 @@ from PYB11Generator import *
 PYB11includes = ['"integrator.hh"',
                 '"rungeKutta4Integrator.cc"',
                 '"rungeKutta2Integrator.cc"',
-                '"crankNicolsonIntegrator.cc"']
+                '"crankNicolsonIntegrator.cc"',
+                '"blockTimestepIntegrator.cc"',
+                '"hermiteIntegrator.cc"',
+                '"rungeKuttaLegendreIntegrator.cc"',
+                '"leapfrogIntegrator.cc"']
 
 from integrator import *
 from rungeKutta4Integrator import *
 from rungeKutta2Integrator import *
-from crankNicolsonIntegrator import *
\ No newline at end of file
+from crankNicolsonIntegrator import *
+from blockTimestepIntegrator import *
+from hermiteIntegrator import *
+from rungeKuttaLegendreIntegrator import *
+from leapfrogIntegrator import *
\ No newline at end of file
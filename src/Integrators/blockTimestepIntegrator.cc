@@ -0,0 +1,167 @@
+// Copyright (C) 2025  Cody Raskin
+
+#include "integrator.hh"
+#include "../Physics/kinematics.hh"
+#include <cmath>
+#include <stdexcept>
+
+// Kick-drift-kick leapfrog with hierarchical (power-of-two) block timesteps.
+// One Step() advances a block of length dtmax. Each node sits in a bin l with
+// step dtmax/2^l picked from the package's NodeTimestep, and only the nodes whose
+// step ends on a given substep get new accelerations; everyone else just drifts
+// along on their half-kicked velocity. Bins only move to a coarser step when the
+// current time is aligned with it, so the whole hierarchy is back in sync at the
+// end of every block.
+template <int dim>
+class BlockTimestepIntegrator : public Integrator<dim> {
+protected:
+    double dtmax;
+    int maxLevel;
+    std::vector<std::vector<int>> levels;   // per package, per node
+    long long forceEvaluations = 0;         // active nodes summed over substeps, last block
+    int substeps = 0;
+
+public:
+    using Vector = Lin::Vector<dim>;
+    using VectorField = Field<Vector>;
+
+    BlockTimestepIntegrator(std::vector<Physics<dim>*> packages, double dtmin, double dtmax, bool verbose = false) :
+        Integrator<dim>(packages,dtmin,verbose),
+        dtmax(dtmax),
+        levels(packages.size()) {
+        if (dtmin <= 0 || dtmax < dtmin)
+            throw std::invalid_argument("BlockTimestepIntegrator: need 0 < dtmin <= dtmax");
+        for (Physics<dim>* physics : packages)
+            if (dynamic_cast<Kinematics<dim>*>(physics) == nullptr)
+                throw std::invalid_argument("BlockTimestepIntegrator: " + physics->name() + " is not a Kinematics package");
+        // the finest bin is the first one at or below dtmin
+        maxLevel = std::min(30, std::max(0, (int)std::ceil(std::log2(dtmax/dtmin))));
+        this->dt = dtmax;
+    }
+
+    ~BlockTimestepIntegrator() {}
+
+    virtual void
+    Step() override {
+        if (this->cycle == 0) {
+            for (Physics<dim>* physics : this->packages)
+                physics->ZeroTimeInitialize();
+        }
+
+        forceEvaluations = 0;
+        substeps = 0;
+        for (size_t p = 0; p < this->packages.size(); ++p)
+        {
+            Physics<dim>* physics = this->packages[p];
+            physics->UpdateState();
+            physics->SetStepDt(this->dt);
+            physics->PreStepInitialize();
+
+            AdvanceBlock(dynamic_cast<Kinematics<dim>*>(physics), levels[p]);
+
+            // the nodeList is synchronized again, so hand it back through the usual path
+            // for boundaries and final checks
+            physics->UpdateState();
+            State<dim> finalState = physics->getState()->deepCopy();
+            physics->ApplyBoundaries(&finalState);
+            physics->FinalizeStep(&finalState);
+        }
+
+        this->time += this->dt;
+        this->cycle += 1;
+
+        VoteDt();
+    }
+
+    // the block length is fixed; the packages' timestep requests go into the bins instead
+    virtual void
+    VoteDt() override {
+        if (this->verbose)
+            std::cout << "block of " << this->dt << " took " << substeps << " substeps and "
+                      << forceEvaluations << " force evaluations\n";
+        this->dt = dtmax * this->dtMultiplier;
+    }
+
+    inline long long getForceEvaluations() const { return forceEvaluations; }
+    inline int getSubsteps() const { return substeps; }
+    inline int getMaxLevel() const { return maxLevel; }
+
+protected:
+    int
+    LevelFor(const double nodeDt) const {
+        if (!(nodeDt < this->dt)) return 0;
+        int l = (int)std::ceil(std::log2(this->dt/nodeDt));
+        return std::min(std::max(l, 0), maxLevel);
+    }
+
+    void
+    AdvanceBlock(Kinematics<dim>* physics, std::vector<int>& level) {
+        NodeList* nodeList = physics->getNodeList();
+        const int numNodes = nodeList->size();
+        VectorField* position       = nodeList->getField<Vector>("position");
+        VectorField* velocity       = nodeList->getField<Vector>("velocity");
+        VectorField* acceleration   = nodeList->getField<Vector>("acceleration");
+
+        const long long ticks = 1LL << maxLevel;
+        const double tick = this->dt/ticks;
+        auto stepOf = [&](int l) { return ticks >> l; };
+
+        std::vector<int> active;
+        if ((int)level.size() != numNodes) {
+            // first block (or the nodeList changed): everyone needs an acceleration to be binned
+            active.resize(numNodes);
+            for (int i = 0; i < numNodes; ++i) active[i] = i;
+            physics->EvaluateAccelerations(this->time, active);
+            forceEvaluations += numNodes;
+            level.resize(numNodes);
+            #pragma omp parallel for
+            for (int i = 0; i < numNodes; ++i)
+                level[i] = LevelFor(physics->NodeTimestep(velocity->getValue(i), acceleration->getValue(i)));
+        }
+
+        // every node starts a step at the block boundary
+        #pragma omp parallel for
+        for (int i = 0; i < numNodes; ++i)
+            velocity->setValue(i, velocity->getValue(i) + (0.5*stepOf(level[i])*tick)*acceleration->getValue(i));
+
+        long long t = 0;
+        while (t < ticks) {
+            int finest = 0;
+            #pragma omp parallel for reduction(max:finest)
+            for (int i = 0; i < numNodes; ++i)
+                finest = std::max(finest, level[i]);
+            const long long h = stepOf(finest);
+
+            // predicted drift for everyone, so active nodes see current positions
+            #pragma omp parallel for
+            for (int i = 0; i < numNodes; ++i)
+                position->setValue(i, position->getValue(i) + (h*tick)*velocity->getValue(i));
+            t += h;
+
+            active.clear();
+            for (int i = 0; i < numNodes; ++i)
+                if (t % stepOf(level[i]) == 0)
+                    active.push_back(i);
+
+            physics->EvaluateAccelerations(this->time + t*tick, active);
+            forceEvaluations += active.size();
+            substeps++;
+
+            #pragma omp parallel for
+            for (int k = 0; k < (int)active.size(); ++k) {
+                const int i = active[k];
+                const Vector a = acceleration->getValue(i);
+                Vector v = velocity->getValue(i) + (0.5*stepOf(level[i])*tick)*a;
+
+                int l = LevelFor(physics->NodeTimestep(v, a));
+                // a coarser step has to start on one of its own boundaries
+                while (l < level[i] && t % stepOf(l) != 0) ++l;
+                level[i] = l;
+
+                if (t < ticks)
+                    v += (0.5*stepOf(l)*tick)*a;
+                velocity->setValue(i, v);
+            }
+        }
+    }
+};
@@ -0,0 +1,36 @@
+from PYB11Generator import *
+from integrator import *
+
+@PYB11template("dim")
+class BlockTimestepIntegrator(Integrator):
+    def pyinit(self,
+               packages="std::vector<Physics<%(dim)s>*>",
+               dtmin="double",
+               dtmax="double"):
+        return
+    def pyinit1(self,
+               packages="std::vector<Physics<%(dim)s>*>",
+               dtmin="double", dtmax="double", verbose="bool"):
+        return
+    def Step(self):
+        return
+
+    forceEvaluations = PYB11property("long long", getter="getForceEvaluations", doc="Active nodes summed over the substeps of the last block.")
+    substeps = PYB11property("int", getter="getSubsteps", doc="Substeps taken in the last block.")
+    maxLevel = PYB11property("int", getter="getMaxLevel", doc="The finest timestep bin.")
+    
+BlockTimestepIntegrator1d = PYB11TemplateClass(BlockTimestepIntegrator,
+                              template_parameters = ("1"),
+                              cppname = "BlockTimestepIntegrator<1>",
+                              pyname = "BlockTimestepIntegrator1d",
+                              docext = " (1D).")
+BlockTimestepIntegrator2d = PYB11TemplateClass(BlockTimestepIntegrator,
+                              template_parameters = ("2"),
+                              cppname = "BlockTimestepIntegrator<2>",
+                              pyname = "BlockTimestepIntegrator2d",
+                              docext = " (2D).")
+BlockTimestepIntegrator3d = PYB11TemplateClass(BlockTimestepIntegrator,
+                              template_parameters = ("3"),
+                              cppname = "BlockTimestepIntegrator<3>",
+                              pyname = "BlockTimestepIntegrator3d",
+                              docext = " (3D).")
@@ -0,0 +1,129 @@
+// Copyright (C) 2025  Cody Raskin
+
+#include "integrator.hh"
+#include "../Physics/kinematics.hh"
+#include <map>
+#include <stdexcept>
+
+// Fourth-order Hermite predictor-corrector (Makino & Aarseth 1992).
+// Positions and velocities are predicted with a Taylor series in the acceleration
+// and jerk, the package evaluates both once at the prediction, and the corrector
+// closes the step with the end-point derivatives. Those end-point values are kept
+// for the next step, so it costs a single force sweep per step. The timestep
+// comes from Aarseth's criterion on the interpolated snap and crackle.
+template <int dim>
+class HermiteIntegrator : public Integrator<dim> {
+protected:
+    using Vector = Lin::Vector<dim>;
+    using VectorField = Field<Vector>;
+
+    struct Derivatives {
+        std::vector<Vector> x, v;     // end of the last step, to tell if someone else moved the nodes
+        std::vector<Vector> a, j;
+        double dt = 1e30;             // Aarseth timestep at the end of the last step
+    };
+    std::map<Physics<dim>*, Derivatives> saved;
+    double eta = 0.02;
+
+public:
+    HermiteIntegrator(std::vector<Physics<dim>*> packages, double dtmin, bool verbose = false) :
+        Integrator<dim>(packages,dtmin,verbose) {}
+
+    ~HermiteIntegrator() {}
+
+    virtual State<dim>
+    Integrate(Physics<dim>* physics) override {
+        const double dt = this->dt;
+        Kinematics<dim>* kinematics = dynamic_cast<Kinematics<dim>*>(physics);
+
+        const State<dim>* state = physics->getState();
+        VectorField* x0 = state->template getField<Vector>("position");
+        VectorField* v0 = state->template getField<Vector>("velocity");
+        const int numNodes = state->size();
+
+        Derivatives& d = saved[physics];
+        if (!Current(d, x0, v0)) {
+            if (kinematics == nullptr || !kinematics->EvaluateJerks(state, d.a, d.j))
+                throw std::runtime_error("HermiteIntegrator: " + physics->name() + " can't provide jerks");
+        }
+
+        State<dim> predicted = state->deepCopy();
+        VectorField* xp = predicted.template getField<Vector>("position");
+        VectorField* vp = predicted.template getField<Vector>("velocity");
+        #pragma omp parallel for
+        for (int i = 0; i < numNodes; ++i) {
+            const Vector& a = d.a[i];
+            const Vector& j = d.j[i];
+            xp->setValue(i, x0->getValue(i) + dt*v0->getValue(i) + (dt*dt/2.0)*a + (dt*dt*dt/6.0)*j);
+            vp->setValue(i, v0->getValue(i) + dt*a + (dt*dt/2.0)*j);
+        }
+
+        std::vector<Vector> a1, j1;
+        kinematics->EvaluateJerks(&predicted, a1, j1);
+
+        State<dim> newState = state->deepCopy();
+        VectorField* x1 = newState.template getField<Vector>("position");
+        VectorField* v1 = newState.template getField<Vector>("velocity");
+        double local_dtmin = 1e30;
+        #pragma omp parallel for reduction(min:local_dtmin)
+        for (int i = 0; i < numNodes; ++i) {
+            const Vector& a0 = d.a[i];
+            const Vector& j0 = d.j[i];
+            Vector v = v0->getValue(i) + (dt/2.0)*(a0 + a1[i]) + (dt*dt/12.0)*(j0 - j1[i]);
+            Vector x = x0->getValue(i) + (dt/2.0)*(v0->getValue(i) + v) + (dt*dt/12.0)*(a0 - a1[i]);
+            v1->setValue(i, v);
+            x1->setValue(i, x);
+
+            // snap and crackle from the Hermite interpolant, snap moved to the end of the step
+            Vector a3 = (12.0*(a0 - a1[i]) + (6.0*dt)*(j0 + j1[i]))/(dt*dt*dt);
+            Vector a2 = (-6.0*(a0 - a1[i]) - dt*(4.0*j0 + 2.0*j1[i]))/(dt*dt) + dt*a3;
+            double num = a1[i].magnitude()*a2.magnitude() + j1[i].mag2();
+            double den = j1[i].magnitude()*a3.magnitude() + a2.mag2();
+            if (den > 0.0)
+                local_dtmin = std::min(local_dtmin, std::sqrt(eta*num/den));
+        }
+
+        d.a.swap(a1);
+        d.j.swap(j1);
+        d.x.assign(x1->getValues().begin(), x1->getValues().end());
+        d.v.assign(v1->getValues().begin(), v1->getValues().end());
+        d.dt = local_dtmin;
+        return newState;
+    }
+
+    // same smoothing as Integrator::VoteDt, but on the Aarseth timesteps
+    virtual void
+    VoteDt() override {
+        double smallestDt = 1e30;
+        for (Physics<dim>* physics : this->packages) {
+            double newdt = saved[physics].dt;
+            if (newdt < smallestDt) {
+                smallestDt = newdt;
+                if (this->verbose)
+                    std::cout << physics->name() << " requested timestep of " << newdt << "\n";
+            }
+        }
+
+        double dt = this->dt;
+        dt = (dt < smallestDt ?  dt + 0.2 * (smallestDt - dt) : smallestDt);
+
+        this->dt = std::max(dt, this->dtmin) * this->dtMultiplier;
+    }
+
+    inline double getEta() const { return eta; }
+    inline void setEta(const double value) { eta = value; }
+
+protected:
+    // the saved end-point derivatives are only good if the nodes haven't moved since
+    bool
+    Current(const Derivatives& d, VectorField* x, VectorField* v) const {
+        const int numNodes = x->size();
+        if ((int)d.a.size() != numNodes || (int)d.x.size() != numNodes)
+            return false;
+        bool same = true;
+        #pragma omp parallel for reduction(&&:same)
+        for (int i = 0; i < numNodes; ++i)
+            same = same && d.x[i] == x->getValue(i) && d.v[i] == v->getValue(i);
+        return same;
+    }
+};
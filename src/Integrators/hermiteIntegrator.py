@@ -0,0 +1,33 @@
+from PYB11Generator import *
+from integrator import *
+
+@PYB11template("dim")
+class HermiteIntegrator(Integrator):
+    def pyinit(self,
+               packages="std::vector<Physics<%(dim)s>*>",
+               dtmin="double"):
+        return
+    def pyinit1(self,
+               packages="std::vector<Physics<%(dim)s>*>",
+               dtmin="double", verbose="bool"):
+        return
+    def Step(self):
+        return
+
+    eta = PYB11property("double", getter="getEta", setter="setEta", doc="Accuracy parameter for Aarseth's timestep criterion.")
+    
+HermiteIntegrator1d = PYB11TemplateClass(HermiteIntegrator,
+                              template_parameters = ("1"),
+                              cppname = "HermiteIntegrator<1>",
+                              pyname = "HermiteIntegrator1d",
+                              docext = " (1D).")
+HermiteIntegrator2d = PYB11TemplateClass(HermiteIntegrator,
+                              template_parameters = ("2"),
+                              cppname = "HermiteIntegrator<2>",
+                              pyname = "HermiteIntegrator2d",
+                              docext = " (2D).")
+HermiteIntegrator3d = PYB11TemplateClass(HermiteIntegrator,
+                              template_parameters = ("3"),
+                              cppname = "HermiteIntegrator<3>",
+                              pyname = "HermiteIntegrator3d",
+                              docext = " (3D).")
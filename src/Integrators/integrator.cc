@@ -21,6 +21,7 @@ void Integrator<dim>::Step() {
     for (Physics<dim>* physics : packages)
     {
         physics->UpdateState();
+        physics->SetStepDt(dt);
         physics->PreStepInitialize();
         
         State<dim> finalState = Integrate(physics);
@@ -0,0 +1,46 @@
+// Copyright (C) 2025  Cody Raskin
+
+#include "integrator.hh"
+#include "../Physics/secondOrderPhysics.hh"
+#include <stdexcept>
+
+// Kick-drift leapfrog for SecondOrderPhysics packages, second order in time and with no
+// State copies at all: each package advances its own fields in place, boundaries included.
+// The rate field (xi for WaveEquation) stays half a step ahead of the displacement.
+template <int dim>
+class LeapfrogIntegrator : public Integrator<dim> {
+protected:
+    double lastDt = 0;
+
+public:
+    LeapfrogIntegrator(std::vector<Physics<dim>*> packages, double dtmin, bool verbose = false) :
+        Integrator<dim>(packages,dtmin,verbose) {}
+
+    ~LeapfrogIntegrator() {}
+
+    virtual void
+    Step() override {
+        if (this->cycle == 0) {
+            for (Physics<dim>* physics : this->packages)
+                physics->ZeroTimeInitialize();
+        }
+
+        const double dt = this->dt;
+        const double kickDt = (this->cycle == 0 ? 0.5 * dt : 0.5 * (lastDt + dt));
+        for (Physics<dim>* physics : this->packages) {
+            SecondOrderPhysics<dim>* secondOrder = dynamic_cast<SecondOrderPhysics<dim>*>(physics);
+            if (secondOrder == nullptr)
+                throw std::runtime_error("LeapfrogIntegrator: " + physics->name() + " is not a second order package");
+            physics->SetStepDt(dt);
+            physics->PreStepInitialize();
+            secondOrder->Leapfrog(dt, kickDt);
+            secondOrder->FinalizeLeapfrog();
+        }
+
+        lastDt = dt;
+        this->time += dt;
+        this->cycle += 1;
+
+        this->VoteDt();
+    }
+};
@@ -0,0 +1,31 @@
+from PYB11Generator import *
+from integrator import *
+
+@PYB11template("dim")
+class LeapfrogIntegrator(Integrator):
+    def pyinit(self,
+               packages="std::vector<Physics<%(dim)s>*>",
+               dtmin="double"):
+        return
+    def pyinit1(self,
+               packages="std::vector<Physics<%(dim)s>*>",
+               dtmin="double", verbose="bool"):
+        return
+    def Step(self):
+        return
+    
+LeapfrogIntegrator1d = PYB11TemplateClass(LeapfrogIntegrator,
+                              template_parameters = ("1"),
+                              cppname = "LeapfrogIntegrator<1>",
+                              pyname = "LeapfrogIntegrator1d",
+                              docext = " (1D).")
+LeapfrogIntegrator2d = PYB11TemplateClass(LeapfrogIntegrator,
+                              template_parameters = ("2"),
+                              cppname = "LeapfrogIntegrator<2>",
+                              pyname = "LeapfrogIntegrator2d",
+                              docext = " (2D).")
+LeapfrogIntegrator3d = PYB11TemplateClass(LeapfrogIntegrator,
+                              template_parameters = ("3"),
+                              cppname = "LeapfrogIntegrator<3>",
+                              pyname = "LeapfrogIntegrator3d",
+                              docext = " (3D).") 
\ No newline at end of file
@@ -0,0 +1,141 @@
+// Copyright (C) 2025  Cody Raskin
+
+#include "integrator.hh"
+#include <cmath>
+#include <stdexcept>
+
+// Runge-Kutta-Legendre super-time-stepping (Meyer, Balsara & Aslam 2014) for parabolic
+// packages. A step of s stages is stable out to (s^2+s)/2 (RKL1) or (s^2+s-2)/4 (RKL2)
+// explicit timesteps, using nothing but EvaluateDerivatives and State arithmetic, so a
+// diffusion package can take steps an order of magnitude past its explicit limit without
+// a linear solve.
+//
+// VoteDt stretches the packages' explicit timestep by that factor. For operator splitting,
+// Advance(dt) takes one step of exactly dt with just enough stages to keep it stable,
+// e.g. with the dt a hydro integrator just took.
+template <int dim>
+class RungeKuttaLegendreIntegrator : public Integrator<dim> {
+protected:
+    int order;
+    int stages;
+    int lastStages = 0;
+    double explicitDt = 0.0;   // smallest package timestep from the last VoteDt
+
+public:
+    RungeKuttaLegendreIntegrator(std::vector<Physics<dim>*> packages, double dtmin, int stages, int order = 2, bool verbose = false) :
+        Integrator<dim>(packages,dtmin,verbose), order(order), stages(stages) {
+        if (order != 1 && order != 2)
+            throw std::invalid_argument("RungeKuttaLegendreIntegrator: order must be 1 or 2");
+        if (stages < order)
+            throw std::invalid_argument("RungeKuttaLegendreIntegrator: need at least as many stages as the order");
+    }
+
+    ~RungeKuttaLegendreIntegrator() {}
+
+    // how many explicit timesteps one step of s stages covers
+    double
+    StabilityGain(const int s) const {
+        return (order == 1 ? 0.5 * (s * s + s) : 0.25 * (s * s + s - 2));
+    }
+
+    // fewest stages that keep a step of dt stable, given the last explicit timestep
+    int
+    StagesFor(const double dt) const {
+        if (explicitDt <= 0.0) return stages;
+        double r = dt / explicitDt;
+        int s = (order == 1 ? (int)std::ceil(0.5 * (-1.0 + std::sqrt(1.0 + 8.0 * r)))
+                            : (int)std::ceil(0.5 * (-1.0 + std::sqrt(9.0 + 16.0 * r))));
+        return std::max(s, order);
+    }
+
+    void
+    Advance(const double dt) {
+        this->dt = dt;
+        int configured = stages;
+        stages = StagesFor(dt);
+        this->Step();
+        stages = configured;
+    }
+
+    virtual State<dim>
+    Integrate(Physics<dim>* physics) override {
+        const double dt = this->dt;
+        const double time = this->time;
+        const int s = stages;
+        lastStages = s;
+
+        const State<dim>* y0 = physics->getState();
+        State<dim> L0(y0->size());
+        State<dim> L(y0->size());
+        L0.ghost(y0);
+        L.ghost(y0);
+
+        physics->EvaluateDerivatives(y0, L0, time, 0);
+
+        // b_j from the Legendre recursion; RKL1 doesn't need them
+        auto b = [](int j) { return (j < 2 ? 1.0 / 3.0 : (j * j + j - 2.0) / (2.0 * j * (j + 1.0))); };
+        const double w1 = (order == 1 ? 2.0 / (s * s + s) : 4.0 / (s * s + s - 2.0));
+
+        // Y_1 = Y_0 + mu~_1 dt L(Y_0)
+        double muTilde1 = (order == 1 ? w1 : b(1) * w1);
+        State<dim> yjm2 = y0->deepCopy();
+        State<dim> yjm1 = y0->deepCopy();
+        yjm1 += L0 * (muTilde1 * dt);
+        double cjm2 = 0.0, cjm1 = muTilde1;   // stage times as fractions of dt
+
+        for (int j = 2; j <= s; ++j) {
+            physics->EvaluateDerivatives(&yjm1, L, time, cjm1 * dt);
+
+            double mu, nu, muTilde, gammaTilde = 0.0;
+            if (order == 1) {
+                mu = (2.0 * j - 1.0) / j;
+                nu = -(j - 1.0) / j;
+                muTilde = mu * w1;
+            } else {
+                mu = (2.0 * j - 1.0) / j * b(j) / b(j - 1);
+                nu = -(j - 1.0) / j * b(j) / b(j - 2);
+                muTilde = mu * w1;
+                gammaTilde = -(1.0 - b(j - 1)) * muTilde;
+            }
+
+            State<dim> yj = yjm1 * mu;
+            yj += yjm2 * nu;
+            if (order == 2)
+                yj += (*y0) * (1.0 - mu - nu);
+            yj += L * (muTilde * dt);
+            if (gammaTilde != 0.0)
+                yj += L0 * (gammaTilde * dt);
+
+            double cj = mu * cjm1 + nu * cjm2 + muTilde + gammaTilde;
+            yjm2 = yjm1;
+            yjm1 = yj;
+            cjm2 = cjm1;
+            cjm1 = cj;
+        }
+        return yjm1;
+    }
+
+    virtual void
+    VoteDt() override {
+        double smallestDt = 1e30;
+        for (Physics<dim>* physics : this->packages) {
+            double newdt = physics->EstimateTimestep();
+            if (newdt < smallestDt) {
+                smallestDt = newdt;
+                if (this->verbose)
+                    std::cout << physics->name() << " requested timestep of " << newdt << "\n";
+            }
+        }
+        explicitDt = smallestDt;
+
+        double target = smallestDt * StabilityGain(stages);
+        double dt = this->dt;
+        dt = (dt < target ? dt + 0.2 * (target - dt) : target);
+        this->dt = std::max(dt, this->dtmin) * this->dtMultiplier;
+    }
+
+    inline int getOrder() const { return order; }
+    inline int getStages() const { return stages; }
+    inline void setStages(const int value) { stages = std::max(value, order); }
+    inline int getLastStages() const { return lastStages; }
+};
@@ -0,0 +1,47 @@
+from PYB11Generator import *
+from integrator import *
+
+@PYB11template("dim")
+class RungeKuttaLegendreIntegrator(Integrator):
+    def pyinit(self,
+               packages="std::vector<Physics<%(dim)s>*>",
+               dtmin="double",
+               stages="int"):
+        return
+    def pyinit1(self,
+               packages="std::vector<Physics<%(dim)s>*>",
+               dtmin="double", stages="int", order="int"):
+        "order is 1 (RKL1) or 2 (RKL2)"
+        return
+    def pyinit2(self,
+               packages="std::vector<Physics<%(dim)s>*>",
+               dtmin="double", stages="int", order="int", verbose="bool"):
+        return
+    def Step(self):
+        return
+    def Advance(self, dt="const double"):
+        "Take one step of exactly dt with as few stages as keep it stable, for operator splitting."
+        return "void"
+    def StabilityGain(self, s="const int"):
+        "Explicit timesteps covered by one step of s stages."
+        return "double"
+
+    order = PYB11property("int", getter="getOrder")
+    stages = PYB11property("int", getter="getStages", setter="setStages", doc="Stages per step.")
+    lastStages = PYB11property("int", getter="getLastStages", doc="Stages taken in the last step.")
+    
+RungeKuttaLegendreIntegrator1d = PYB11TemplateClass(RungeKuttaLegendreIntegrator,
+                              template_parameters = ("1"),
+                              cppname = "RungeKuttaLegendreIntegrator<1>",
+                              pyname = "RungeKuttaLegendreIntegrator1d",
+                              docext = " (1D).")
+RungeKuttaLegendreIntegrator2d = PYB11TemplateClass(RungeKuttaLegendreIntegrator,
+                              template_parameters = ("2"),
+                              cppname = "RungeKuttaLegendreIntegrator<2>",
+                              pyname = "RungeKuttaLegendreIntegrator2d",
+                              docext = " (2D).")
+RungeKuttaLegendreIntegrator3d = PYB11TemplateClass(RungeKuttaLegendreIntegrator,
+                              template_parameters = ("3"),
+                              cppname = "RungeKuttaLegendreIntegrator<3>",
+                              pyname = "RungeKuttaLegendreIntegrator3d",
+                              docext = " (3D).")
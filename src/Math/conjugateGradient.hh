@@ -0,0 +1,75 @@
+// Copyright (C) 2025  Cody Raskin
+
+#pragma once
+
+#include <vector>
+#include <cmath>
+
+namespace Lin {
+
+// Matrix-free preconditioned conjugate gradient for a symmetric positive definite A.
+// A(x, y) sets y = A x and M(r, z) sets z = M^-1 r, both on vectors of b's length.
+// x holds the initial guess on entry; iteration stops once |r| <= tolerance * |b|.
+// Returns the number of iterations taken, and the final |r| / |b| in relativeResidual.
+template <typename Operator, typename Preconditioner>
+int
+pcg(const Operator& A, const Preconditioner& M, const std::vector<double>& b, std::vector<double>& x,
+    const double tolerance, const int maxIterations, double* relativeResidual = nullptr) {
+    const int n = b.size();
+    std::vector<double> r(n), z(n), p(n), Ap(n);
+
+    A(x, Ap);
+    double bnorm = 0.0;
+    #pragma omp parallel for reduction(+:bnorm)
+    for (int i = 0; i < n; ++i) {
+        r[i] = b[i] - Ap[i];
+        bnorm += b[i] * b[i];
+    }
+    bnorm = std::sqrt(bnorm);
+    if (bnorm == 0.0) bnorm = 1.0;
+
+    M(r, z);
+    double rz = 0.0, rr = 0.0;
+    #pragma omp parallel for reduction(+:rz,rr)
+    for (int i = 0; i < n; ++i) {
+        p[i] = z[i];
+        rz += r[i] * z[i];
+        rr += r[i] * r[i];
+    }
+
+    int it = 0;
+    while (std::sqrt(rr) > tolerance * bnorm && it < maxIterations) {
+        A(p, Ap);
+        double pAp = 0.0;
+        #pragma omp parallel for reduction(+:pAp)
+        for (int i = 0; i < n; ++i)
+            pAp += p[i] * Ap[i];
+        if (pAp <= 0.0) break;   // not positive definite along p, nothing more to gain
+
+        const double alpha = rz / pAp;
+        rr = 0.0;
+        #pragma omp parallel for reduction(+:rr)
+        for (int i = 0; i < n; ++i) {
+            x[i] += alpha * p[i];
+            r[i] -= alpha * Ap[i];
+            rr += r[i] * r[i];
+        }
+
+        M(r, z);
+        double rzNew = 0.0;
+        #pragma omp parallel for reduction(+:rzNew)
+        for (int i = 0; i < n; ++i)
+            rzNew += r[i] * z[i];
+        const double beta = rzNew / rz;
+        rz = rzNew;
+        #pragma omp parallel for
+        for (int i = 0; i < n; ++i)
+            p[i] = z[i] + beta * p[i];
+        it++;
+    }
+
+    if (relativeResidual) *relativeResidual = std::sqrt(rr) / bnorm;
+    return it;
+}
+
+}
@@ -0,0 +1,137 @@
+// Copyright (C) 2025  Cody Raskin
+
+#pragma once
+
+#include <vector>
+#include <array>
+#include <complex>
+#include <cmath>
+
+namespace Lin {
+
+// Small header-only FFT for power-of-two sizes. Transforms are unnormalized in both
+// directions (like FFTW), so a forward/inverse round trip multiplies by the size.
+// Multi-dimensional arrays are stored x fastest, matching Mesh::Grid::index.
+
+using Complex = std::complex<double>;
+
+inline bool
+isPowerOfTwo(const int n) { return n > 0 && (n & (n - 1)) == 0; }
+
+// in-place iterative radix-2 transform of n contiguous values. sign = -1 forward, +1 inverse
+inline void
+fft(Complex* data, const int n, const int sign) {
+    for (int i = 1, j = 0; i < n; ++i) {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(data[i], data[j]);
+    }
+    for (int len = 2; len <= n; len <<= 1) {
+        const double angle = sign * 2.0 * M_PI / len;
+        const Complex wlen(std::cos(angle), std::sin(angle));
+        for (int i = 0; i < n; i += len) {
+            Complex w(1.0, 0.0);
+            for (int k = 0; k < len / 2; ++k) {
+                Complex u = data[i + k];
+                Complex v = data[i + k + len / 2] * w;
+                data[i + k]           = u + v;
+                data[i + k + len / 2] = u - v;
+                w *= wlen;
+            }
+        }
+    }
+}
+
+// n reals -> n/2+1 complex, done as one n/2-point complex transform of the even/odd pairs.
+// work must hold n/2 values
+inline void
+rfft(const double* in, Complex* out, const int n, Complex* work) {
+    const int m = n / 2;
+    for (int k = 0; k < m; ++k) work[k] = Complex(in[2 * k], in[2 * k + 1]);
+    fft(work, m, -1);
+    for (int k = 0; k <= m; ++k) {
+        Complex zk  = work[k % m];
+        Complex zmk = std::conj(work[(m - k) % m]);
+        Complex even = 0.5 * (zk + zmk);
+        Complex odd  = Complex(0.0, -0.5) * (zk - zmk);
+        out[k] = even + std::polar(1.0, -M_PI * k / m) * odd;
+    }
+}
+
+// n/2+1 complex -> n reals, the inverse of rfft (times n)
+inline void
+irfft(const Complex* in, double* out, const int n, Complex* work) {
+    const int m = n / 2;
+    for (int k = 0; k < m; ++k) {
+        Complex xk  = in[k];
+        Complex xmk = std::conj(in[m - k]);
+        Complex even = 0.5 * (xk + xmk);
+        Complex odd  = 0.5 * (xk - xmk) * std::polar(1.0, M_PI * k / m);
+        work[k] = even + Complex(0.0, 1.0) * odd;
+    }
+    fft(work, m, +1);
+    for (int k = 0; k < m; ++k) {
+        out[2 * k]     = 2.0 * work[k].real();
+        out[2 * k + 1] = 2.0 * work[k].imag();
+    }
+}
+
+// complex transform along axis 1 or 2 of a (nx, ny, nz) array, one line per thread at a time
+inline void
+fftAxis(std::vector<Complex>& data, const std::array<int, 3>& n, const int axis, const int sign) {
+    const int len = n[axis];
+    if (len == 1) return;
+    const int stride = (axis == 1 ? n[0] : n[0] * n[1]);
+    const int lines  = n[0] * n[1] * n[2] / len;
+    #pragma omp parallel
+    {
+        std::vector<Complex> line(len);
+        #pragma omp for
+        for (int l = 0; l < lines; ++l) {
+            // l enumerates every index with the axis coordinate zeroed out
+            int base = (l % stride) + (l / stride) * stride * len;
+            for (int k = 0; k < len; ++k) line[k] = data[base + k * stride];
+            fft(line.data(), len, sign);
+            for (int k = 0; k < len; ++k) data[base + k * stride] = line[k];
+        }
+    }
+}
+
+// real (nx, ny, nz) -> complex (nx/2+1, ny, nz)
+inline void
+rfftn(const std::vector<double>& in, std::vector<Complex>& out, const std::array<int, 3>& n) {
+    const int hx = n[0] / 2 + 1;
+    const int rows = n[1] * n[2];
+    out.resize(hx * rows);
+    #pragma omp parallel
+    {
+        std::vector<Complex> work(n[0] / 2);
+        #pragma omp for
+        for (int r = 0; r < rows; ++r)
+            rfft(&in[r * n[0]], &out[r * hx], n[0], work.data());
+    }
+    std::array<int, 3> h = {hx, n[1], n[2]};
+    fftAxis(out, h, 1, -1);
+    fftAxis(out, h, 2, -1);
+}
+
+// complex (nx/2+1, ny, nz) -> real (nx, ny, nz). in is used as scratch
+inline void
+irfftn(std::vector<Complex>& in, std::vector<double>& out, const std::array<int, 3>& n) {
+    const int hx = n[0] / 2 + 1;
+    const int rows = n[1] * n[2];
+    std::array<int, 3> h = {hx, n[1], n[2]};
+    fftAxis(in, h, 2, +1);
+    fftAxis(in, h, 1, +1);
+    out.resize(n[0] * rows);
+    #pragma omp parallel
+    {
+        std::vector<Complex> work(n[0] / 2);
+        #pragma omp for
+        for (int r = 0; r < rows; ++r)
+            irfft(&in[r * hx], &out[r * n[0]], n[0], work.data());
+    }
+}
+
+}
@@ -4,6 +4,7 @@
 
 #include <vector>
 #include <cmath>
+#include <algorithm>
 
 namespace Lin {
 
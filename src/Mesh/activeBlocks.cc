@@ -0,0 +1,80 @@
+// Copyright (C) 2025  Cody Raskin
+
+#ifndef ACTIVEBLOCKS_CC
+#define ACTIVEBLOCKS_CC
+
+#include "activeBlocks.hh"
+#include <algorithm>
+
+namespace Mesh {
+    template <int dim>
+    ActiveBlocks<dim>::ActiveBlocks(Grid<dim>* grid, int blockSize, int reach) :
+        grid(grid), blockSize(std::max(blockSize, 1)) {
+        radius = std::max(1, (reach + this->blockSize - 1) / this->blockSize);
+        const std::array<int, 3> n = {grid->nx, grid->ny, grid->nz};
+        for (int d = 0; d < 3; ++d)
+            nb[d] = (n[d] + this->blockSize - 1) / this->blockSize;
+
+        const int numCells = grid->size();
+        const int numBlocks = nb[0] * nb[1] * nb[2];
+        blockOf.resize(numCells);
+        blockStart.assign(numBlocks + 1, 0);
+        for (int i = 0; i < numCells; ++i) {
+            const std::array<int, 3> c = grid->indexToCoordinates(i);
+            blockOf[i] = ((c[2] / this->blockSize) * nb[1] + c[1] / this->blockSize) * nb[0] + c[0] / this->blockSize;
+            blockStart[blockOf[i] + 1]++;
+        }
+        for (int b = 0; b < numBlocks; ++b) blockStart[b + 1] += blockStart[b];
+        blockCells.resize(numCells);
+        std::vector<int> fill(blockStart.begin(), blockStart.end() - 1);
+        for (int i = 0; i < numCells; ++i) blockCells[fill[blockOf[i]]++] = i;
+
+        touched.assign(numBlocks, 1);
+        active.assign(numBlocks, 1);
+        activeBlocks = numBlocks;
+    }
+
+    template <int dim>
+    void
+    ActiveBlocks<dim>::activateAll() {
+        std::fill(active.begin(), active.end(), 1);
+        activeBlocks = active.size();
+        stale = true;
+    }
+
+    template <int dim>
+    void
+    ActiveBlocks<dim>::dilate() {
+        const int numBlocks = active.size();
+        int count = 0;
+        #pragma omp parallel for reduction(+:count)
+        for (int b = 0; b < numBlocks; ++b) {
+            const int bx = b % nb[0], by = (b / nb[0]) % nb[1], bz = b / (nb[0] * nb[1]);
+            char any = 0;
+            for (int z = std::max(bz - radius, 0); z <= std::min(bz + radius, nb[2] - 1) && !any; ++z)
+                for (int y = std::max(by - radius, 0); y <= std::min(by + radius, nb[1] - 1) && !any; ++y)
+                    for (int x = std::max(bx - radius, 0); x <= std::min(bx + radius, nb[0] - 1); ++x)
+                        if (touched[(z * nb[1] + y) * nb[0] + x]) { any = 1; break; }
+            active[b] = any;
+            count += any;
+        }
+        activeBlocks = count;
+        stale = true;
+    }
+
+    template <int dim>
+    const std::vector<int>&
+    ActiveBlocks<dim>::select(const std::vector<int>& cells) {
+        if (stale || selectedFrom != &cells) {
+            selected.clear();
+            selected.reserve(cells.size());
+            for (int i : cells)
+                if (active[blockOf[i]]) selected.push_back(i);
+            selectedFrom = &cells;
+            stale = false;
+        }
+        return selected;
+    }
+}
+
+#endif // ACTIVEBLOCKS_CC
@@ -0,0 +1,67 @@
+// Copyright (C) 2025  Cody Raskin
+
+#pragma once
+
+#include <vector>
+#include <array>
+#include "grid.hh"
+
+namespace Mesh {
+    // Activity mask over a Grid cut into blocks of blockSize cells a side. update() asks
+    // each cell whether it changed since the last update. A block is active if it, or a
+    // block within `radius` blocks of it, had a changed cell, where radius covers `reach`
+    // cells: how far information can travel through a solver's stencil in one step. A
+    // solver then only needs to evaluate the cells of active blocks, since every other
+    // cell sees the same inputs as the last step, when nothing changed.
+    template <int dim>
+    class ActiveBlocks {
+    public:
+        ActiveBlocks(Grid<dim>* grid, int blockSize, int reach);
+
+        // changed(cell) -> bool is called exactly once for every cell of the grid, in
+        // parallel over blocks, so it may update a per-cell snapshot as it goes
+        template <typename Changed>
+        void update(Changed&& changed);
+
+        void activateAll();
+
+        // the cells of `cells` that lie in active blocks, in their original order
+        const std::vector<int>& select(const std::vector<int>& cells);
+
+        inline bool isActive(int cell) const { return active[blockOf[cell]]; }
+        inline int numBlocks() const { return active.size(); }
+        inline int numActiveBlocks() const { return activeBlocks; }
+        inline int getBlockSize() const { return blockSize; }
+
+    private:
+        Grid<dim>* grid;
+        int blockSize, radius;
+        std::array<int, 3> nb;                  // blocks along each axis
+        std::vector<int> blockOf;               // block of each cell
+        std::vector<int> blockStart, blockCells;  // cells of each block, CSR
+        std::vector<char> touched, active;
+        int activeBlocks = 0;
+        std::vector<int> selected;
+        const std::vector<int>* selectedFrom = nullptr;
+        bool stale = true;
+
+        void dilate();
+    };
+
+    template <int dim>
+    template <typename Changed>
+    void
+    ActiveBlocks<dim>::update(Changed&& changed) {
+        const int numBlocks = active.size();
+        #pragma omp parallel for schedule(dynamic, 4)
+        for (int b = 0; b < numBlocks; ++b) {
+            char any = 0;
+            for (int k = blockStart[b]; k < blockStart[b + 1]; ++k)
+                if (changed(blockCells[k])) any = 1;
+            touched[b] = any;
+        }
+        dilate();
+    }
+}
+
+#include "activeBlocks.cc"
@@ -6,6 +6,7 @@
 #include "femesh.hh"
 #include <stdexcept>
 #include <set>
+#include <algorithm>
 #include "../IO/importObj.cc"
 #include <iostream>
 #include <fstream>
@@ -134,7 +135,17 @@ buildFromObj2dHelper(FEMesh<2>& mesh, const std::string& filepath, const std::st
         mesh.addNode(v);
     }
     int tris=0,quads=0;
-    for (const auto& face : faces.getValues()) {
+    for (auto face : faces.getValues()) {
+        // the elements want their nodes counter-clockwise, which a face keeps or loses
+        // depending on which plane it is projected onto
+        double signedArea = 0.0;
+        for (size_t a = 0; a < face.size(); ++a) {
+            const auto& p = vertices.getValue(face[a] - 1);
+            const auto& q = vertices.getValue(face[(a + 1) % face.size()] - 1);
+            signedArea += p.x() * q.y() - q.x() * p.y();
+        }
+        if (signedArea < 0.0) std::reverse(face.begin(), face.end());
+
         if (face.size() == 3) {
             tris++;
             mesh.addElement(ElementType::Triangle, {
@@ -0,0 +1,307 @@
+// Copyright (C) 2025  Cody Raskin
+
+#ifndef MULTIGRID_CC
+#define MULTIGRID_CC
+
+#include "multigrid.hh"
+#include <cmath>
+#include <algorithm>
+
+namespace Mesh {
+    template <int dim>
+    Multigrid<dim>::Multigrid(Grid<dim>* grid, BoundaryType boundary) :
+        grid(grid), boundary(boundary) {
+        Level L;
+        L.n = {grid->getnx(), grid->getny(), grid->getnz()};
+        L.h = {grid->getdx(), grid->getdy(), grid->getdz()};
+        while (true) {
+            L.phi.assign(L.size(), 0.0);
+            L.rhs.assign(L.size(), 0.0);
+            L.res.assign(L.size(), 0.0);
+            levels.push_back(L);
+
+            bool coarsen = true;
+            for (int d = 0; d < dim; ++d)
+                coarsen = coarsen && L.n[d] % 2 == 0 && L.n[d] >= 4;
+            if (!coarsen) break;
+            for (int d = 0; d < dim; ++d) {
+                L.n[d] /= 2;
+                L.h[d] *= 2.0;
+            }
+        }
+
+        const Level& fine = levels[0];
+        for (int d = 0; d < dim; ++d) {
+            int o1 = (d + 1) % 3, o2 = (d + 2) % 3;
+            for (int s = 0; s < 2; ++s)
+                faceValues[d][s].assign(fine.n[o1] * fine.n[o2], 0.0);
+        }
+    }
+
+    template <int dim>
+    int
+    Multigrid<dim>::faceIndex(const Level& L, const std::array<int, 3>& c, int axis) const {
+        int o1 = (axis + 1) % 3, o2 = (axis + 2) % 3;
+        return c[o2] * L.n[o1] + c[o1];
+    }
+
+    template <int dim>
+    void
+    Multigrid<dim>::fillFaceValues() {
+        if (boundary != BoundaryType::Dirichlet || !boundaryValues) return;
+        const Level& L = levels[0];
+        for (int d = 0; d < dim; ++d) {
+            int o1 = (d + 1) % 3, o2 = (d + 2) % 3;
+            for (int s = 0; s < 2; ++s) {
+                const int count = L.n[o1] * L.n[o2];
+                #pragma omp parallel for
+                for (int f = 0; f < count; ++f) {
+                    std::array<int, 3> c;
+                    c[o1] = f % L.n[o1];
+                    c[o2] = f / L.n[o1];
+                    c[d]  = (s == 0 ? 0 : L.n[d] - 1);
+                    faceValues[d][s][f] = boundaryValues(L.index(c[0], c[1], c[2]), d, 2 * s - 1);
+                }
+            }
+        }
+    }
+
+    // sum over the stencil's neighbors (w/h^2 each) and the matching diagonal, with the
+    // boundary folded in: a Dirichlet ghost is 2b - phi_c, which is 0 - phi_c on coarse levels
+    template <int dim>
+    inline void
+    Multigrid<dim>::stencil(int l, const std::array<int, 3>& c, double& sum, double& diag) const {
+        const Level& L = levels[l];
+        sum = 0.0;
+        diag = 0.0;
+        for (int d = 0; d < dim; ++d) {
+            const double w = 1.0 / (L.h[d] * L.h[d]);
+            for (int side = -1; side <= 1; side += 2) {
+                std::array<int, 3> nb = c;
+                nb[d] += side;
+                if (nb[d] < 0 || nb[d] >= L.n[d]) {
+                    if (boundary == BoundaryType::Periodic) {
+                        nb[d] = (nb[d] + L.n[d]) % L.n[d];
+                    } else {
+                        double b = (l == 0 ? faceValues[d][(side + 1) / 2][faceIndex(L, c, d)] : 0.0);
+                        sum  += 2.0 * w * b;
+                        diag += 2.0 * w;
+                        continue;
+                    }
+                }
+                sum  += w * L.phi[L.index(nb[0], nb[1], nb[2])];
+                diag += w;
+            }
+        }
+    }
+
+    template <int dim>
+    void
+    Multigrid<dim>::smooth(int l, int numSweeps) {
+        Level& L = levels[l];
+        const int size = L.size();
+        // across a periodic axis of odd length two neighbors share a color, so the colors
+        // are no longer independent and the sweep has to run in order
+        bool independent = true;
+        for (int d = 0; d < dim; ++d)
+            if (boundary == BoundaryType::Periodic && L.n[d] % 2 == 1) independent = false;
+        for (int sweep = 0; sweep < numSweeps; ++sweep) {
+            for (int color = 0; color < 2; ++color) {
+                #pragma omp parallel for if(independent)
+                for (int idx = 0; idx < size; ++idx) {
+                    std::array<int, 3> c = {idx % L.n[0], (idx / L.n[0]) % L.n[1], idx / (L.n[0] * L.n[1])};
+                    if ((c[0] + c[1] + c[2]) % 2 != color) continue;
+                    double sum, diag;
+                    stencil(l, c, sum, diag);
+                    L.phi[idx] = (sum - L.rhs[idx]) / diag;
+                }
+            }
+        }
+    }
+
+    template <int dim>
+    void
+    Multigrid<dim>::residual(int l) {
+        Level& L = levels[l];
+        const int size = L.size();
+        #pragma omp parallel for
+        for (int idx = 0; idx < size; ++idx) {
+            std::array<int, 3> c = {idx % L.n[0], (idx / L.n[0]) % L.n[1], idx / (L.n[0] * L.n[1])};
+            double sum, diag;
+            stencil(l, c, sum, diag);
+            L.res[idx] = L.rhs[idx] - (sum - diag * L.phi[idx]);
+        }
+    }
+
+    template <int dim>
+    double
+    Multigrid<dim>::norm(const std::vector<double>& v) const {
+        double s = 0.0;
+        #pragma omp parallel for reduction(+:s)
+        for (int i = 0; i < (int)v.size(); ++i)
+            s += v[i] * v[i];
+        return std::sqrt(s / std::max<size_t>(v.size(), 1));
+    }
+
+    template <int dim>
+    void
+    Multigrid<dim>::removeMean(std::vector<double>& v) const {
+        double s = 0.0;
+        #pragma omp parallel for reduction(+:s)
+        for (int i = 0; i < (int)v.size(); ++i)
+            s += v[i];
+        s /= v.size();
+        #pragma omp parallel for
+        for (int i = 0; i < (int)v.size(); ++i)
+            v[i] -= s;
+    }
+
+    // coarse rhs is the average of the 2^dim fine residuals underneath
+    template <int dim>
+    void
+    Multigrid<dim>::restrictResidual(int l) {
+        const Level& F = levels[l];
+        Level& C = levels[l + 1];
+        const int size = C.size();
+        const double weight = 1.0 / (1 << dim);
+        #pragma omp parallel for
+        for (int idx = 0; idx < size; ++idx) {
+            std::array<int, 3> c = {idx % C.n[0], (idx / C.n[0]) % C.n[1], idx / (C.n[0] * C.n[1])};
+            double s = 0.0;
+            for (int q = 0; q < (1 << dim); ++q) {
+                std::array<int, 3> f = c;
+                for (int d = 0; d < dim; ++d)
+                    f[d] = 2 * c[d] + ((q >> d) & 1);
+                s += F.res[F.index(f[0], f[1], f[2])];
+            }
+            C.rhs[idx] = weight * s;
+            C.phi[idx] = 0.0;
+        }
+        if (boundary == BoundaryType::Periodic)
+            removeMean(C.rhs);
+    }
+
+    // linear interpolation of the coarse correction: 3/4 from the parent, 1/4 from its
+    // neighbor on the fine cell's side, per axis
+    template <int dim>
+    void
+    Multigrid<dim>::prolongAndCorrect(int l) {
+        Level& F = levels[l];
+        const Level& C = levels[l + 1];
+        const int size = F.size();
+        #pragma omp parallel for
+        for (int idx = 0; idx < size; ++idx) {
+            std::array<int, 3> f = {idx % F.n[0], (idx / F.n[0]) % F.n[1], idx / (F.n[0] * F.n[1])};
+            double e = 0.0;
+            for (int q = 0; q < (1 << dim); ++q) {
+                std::array<int, 3> c = {0, 0, 0};
+                double w = 1.0, sign = 1.0;
+                for (int d = 0; d < dim; ++d) {
+                    c[d] = f[d] / 2;
+                    if ((q >> d) & 1) {
+                        c[d] += (f[d] % 2 == 0 ? -1 : 1);
+                        w *= 0.25;
+                    } else
+                        w *= 0.75;
+                    if (c[d] < 0 || c[d] >= C.n[d]) {
+                        if (boundary == BoundaryType::Periodic)
+                            c[d] = (c[d] + C.n[d]) % C.n[d];
+                        else {
+                            c[d] = std::min(std::max(c[d], 0), C.n[d] - 1);
+                            sign = -sign;   // homogeneous Dirichlet ghost
+                        }
+                    }
+                }
+                e += w * sign * C.phi[C.index(c[0], c[1], c[2])];
+            }
+            F.phi[idx] += e;
+        }
+    }
+
+    template <int dim>
+    void
+    Multigrid<dim>::vcycle(int l) {
+        if (l == (int)levels.size() - 1) {
+            const Level& L = levels[l];
+            int nmax = std::max(L.n[0], std::max(L.n[1], L.n[2]));
+            smooth(l, std::min(2000, std::max(20, 2 * nmax * nmax)));
+            return;
+        }
+        smooth(l, sweeps);
+        residual(l);
+        restrictResidual(l);
+        vcycle(l + 1);
+        prolongAndCorrect(l);
+        smooth(l, sweeps);
+    }
+
+    template <int dim>
+    void
+    Multigrid<dim>::fcycleAt(int l) {
+        if (l == (int)levels.size() - 1) {
+            vcycle(l);
+            return;
+        }
+        smooth(l, sweeps);
+        residual(l);
+        restrictResidual(l);
+        fcycleAt(l + 1);
+        vcycle(l + 1);
+        prolongAndCorrect(l);
+        smooth(l, sweeps);
+    }
+
+    template <int dim>
+    int
+    Multigrid<dim>::solve(std::vector<double>& phi, const std::vector<double>& rhs,
+                          double tolerance, int maxCycles) {
+        Level& L = levels[0];
+        L.phi = phi;
+        L.rhs = rhs;
+        if (boundary == BoundaryType::Periodic)
+            removeMean(L.rhs);
+        fillFaceValues();
+
+        residual(0);
+        residualNorm = norm(L.res);
+        double target = tolerance * (norm(L.rhs) > 0.0 ? norm(L.rhs) : residualNorm);
+
+        int cycles = 0;
+        while (residualNorm > target && cycles < maxCycles) {
+            if (fcycle) fcycleAt(0);
+            else        vcycle(0);
+            residual(0);
+            residualNorm = norm(L.res);
+            cycles++;
+        }
+
+        if (boundary == BoundaryType::Periodic)
+            removeMean(L.phi);
+        phi = L.phi;
+        return cycles;
+    }
+
+    template <int dim>
+    double
+    Multigrid<dim>::gradient(const std::vector<double>& phi, int cell, int axis) const {
+        const Level& L = levels[0];
+        std::array<int, 3> c = {cell % L.n[0], (cell / L.n[0]) % L.n[1], cell / (L.n[0] * L.n[1])};
+        double v[2];
+        for (int s = 0; s < 2; ++s) {
+            std::array<int, 3> nb = c;
+            nb[axis] += 2 * s - 1;
+            if (nb[axis] < 0 || nb[axis] >= L.n[axis]) {
+                if (boundary == BoundaryType::Periodic)
+                    nb[axis] = (nb[axis] + L.n[axis]) % L.n[axis];
+                else {
+                    v[s] = 2.0 * faceValues[axis][s][faceIndex(L, c, axis)] - phi[cell];
+                    continue;
+                }
+            }
+            v[s] = phi[L.index(nb[0], nb[1], nb[2])];
+        }
+        return (v[1] - v[0]) / (2.0 * L.h[axis]);
+    }
+}
+
+#endif
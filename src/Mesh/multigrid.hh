@@ -0,0 +1,82 @@
+// Copyright (C) 2025  Cody Raskin
+
+#pragma once
+
+#include <vector>
+#include <array>
+#include <functional>
+#include <algorithm>
+#include "grid.hh"
+
+namespace Mesh {
+    // Geometric multigrid for the cell-centered Poisson problem lap(phi) = rhs on a Grid.
+    // Levels are made by halving every axis while it stays even, red-black Gauss-Seidel
+    // does the smoothing (each color in parallel, unless an odd periodic axis couples the
+    // colors), and corrections come back up with
+    // (bi/tri)linear interpolation. Dirichlet values sit on the cell faces at the edge of
+    // the grid; a periodic problem has the mean of rhs removed and the mean of phi pinned to 0.
+    template <int dim>
+    class Multigrid {
+    public:
+        enum class BoundaryType { Dirichlet, Periodic };
+
+        // value of phi on the face of boundary cell `cell` normal to `axis`, side -1 or +1
+        using BoundaryFunction = std::function<double(int cell, int axis, int side)>;
+
+        Multigrid(Grid<dim>* grid, BoundaryType boundary);
+
+        // phi holds the initial guess on entry. returns the number of cycles taken
+        int solve(std::vector<double>& phi, const std::vector<double>& rhs,
+                  double tolerance, int maxCycles);
+
+        void setBoundaryValues(BoundaryFunction f) { boundaryValues = f; }
+
+        // d phi / d x_axis at a cell, using the same boundary treatment as the solve
+        double gradient(const std::vector<double>& phi, int cell, int axis) const;
+
+        inline int numLevels() const { return levels.size(); }
+        // cells along the longest axis of the coarsest level, which is solved by smoothing alone
+        inline int coarsestSize() const {
+            int n = 1;
+            for (int d = 0; d < dim; ++d) n = std::max(n, levels.back().n[d]);
+            return n;
+        }
+        inline double lastResidual() const { return residualNorm; }
+        inline bool isFCycle() const { return fcycle; }
+        inline void setFCycle(bool value) { fcycle = value; }
+        inline int getSmoothingSweeps() const { return sweeps; }
+        inline void setSmoothingSweeps(int value) { sweeps = value; }
+
+    private:
+        struct Level {
+            std::array<int, 3> n;
+            std::array<double, 3> h;
+            std::vector<double> phi, rhs, res;
+            inline int size() const { return n[0] * n[1] * n[2]; }
+            inline int index(int i, int j, int k) const { return (k * n[1] + j) * n[0] + i; }
+        };
+
+        Grid<dim>* grid;
+        BoundaryType boundary;
+        std::vector<Level> levels;
+        BoundaryFunction boundaryValues;
+        std::array<std::array<std::vector<double>, 2>, 3> faceValues;   // finest level only
+        double residualNorm = 0;
+        bool fcycle = false;
+        int sweeps = 2;
+
+        int faceIndex(const Level& L, const std::array<int, 3>& c, int axis) const;
+        void fillFaceValues();
+        void stencil(int l, const std::array<int, 3>& c, double& sum, double& diag) const;
+        void smooth(int l, int numSweeps);
+        void residual(int l);
+        double norm(const std::vector<double>& v) const;
+        void removeMean(std::vector<double>& v) const;
+        void restrictResidual(int l);
+        void prolongAndCorrect(int l);
+        void vcycle(int l);
+        void fcycleAt(int l);
+    };
+}
+
+#include "multigrid.cc"
@@ -12,30 +12,18 @@ struct HLLFlux {
 
 template<int dim>
 HLLFlux<dim>
-computeHLLEFlux(int iL, int iR, int axis,
-               const Field<double>& rho,
-               const Field<Lin::Vector<dim>>& v,
-               const Field<double>& u,
-               const Field<double>& p,
-               const Field<double>& cs) {
+computeHLLEFluxFromStates(
+    double rhoL, const Lin::Vector<dim>& vL, double uL, double pL, double cL,
+    double rhoR, const Lin::Vector<dim>& vR, double uR, double pR, double cR,
+    int axis) {
     using Vector = Lin::Vector<dim>;
 
     // Left state
-    double rhoL = rho.getValue(iL);
-    Vector vL = v.getValue(iL);
-    double uL = u.getValue(iL);
-    double pL = p.getValue(iL);
-    double cL = cs.getValue(iL);
     Vector momL = vL * rhoL;
     double eL = uL + 0.5 * vL.mag2();
     double EL = rhoL * eL;
 
     // Right state
-    double rhoR = rho.getValue(iR);
-    Vector vR = v.getValue(iR);
-    double uR = u.getValue(iR);
-    double pR = p.getValue(iR);
-    double cR = cs.getValue(iR);
     Vector momR = vR * rhoR;
     double eR = uR + 0.5 * vR.mag2();
     double ER = rhoR * eR;
@@ -80,6 +68,19 @@ computeHLLEFlux(int iL, int iR, int axis,
     return result;
 }
 
+template<int dim>
+HLLFlux<dim>
+computeHLLEFlux(int iL, int iR, int axis,
+               const Field<double>& rho,
+               const Field<Lin::Vector<dim>>& v,
+               const Field<double>& u,
+               const Field<double>& p,
+               const Field<double>& cs) {
+    return computeHLLEFluxFromStates<dim>(rho.getValue(iL), v.getValue(iL), u.getValue(iL), p.getValue(iL), cs.getValue(iL),
+                                          rho.getValue(iR), v.getValue(iR), u.getValue(iR), p.getValue(iR), cs.getValue(iR),
+                                          axis);
+}
+
 //LEGACY UNLIMITED VERSION
 template<int dim>
 HLLFlux<dim>
@@ -246,22 +247,19 @@ computeHLLCFluxFromStates(
         flux.momentum = momFluxR;
         flux.energy = energyFluxR;
     } else {
-        Vector n = unitAxis<dim>(axis);
-
-        double denomL = std::max(sL - sStar, tiny);
-        double denomR = std::max(sR - sStar, tiny);
-
-        double rhoSL = std::max(rhoL * (sL - vnL) / denomL, tiny);
-        double rhoSR = std::max(rhoR * (sR - vnR) / denomR, tiny);
+        // Toro's star states: U*_K = rho_K (S_K - v_K) / (S_K - S*) times
+        // (1, v with its normal part replaced by S*, e_K + (S* - v_K)(S* + P_K / (rho_K (S_K - v_K))))
+        double rhoSL = std::max(rhoL * (sL - vnL) / std::min(sL - sStar, -tiny), tiny);
+        double rhoSR = std::max(rhoR * (sR - vnR) / std::max(sR - sStar, tiny), tiny);
 
-        Vector vL_star = vL - n * vnL;
-        Vector vR_star = vR - n * vnR;
+        Vector vL_star = vL; vL_star[axis] = sStar;
+        Vector vR_star = vR; vR_star[axis] = sStar;
 
-        Vector momSL = momL + (sStar - vnL) * (rhoSL * vL_star);
-        Vector momSR = momR + (sStar - vnR) * (rhoSR * vR_star);
+        Vector momSL = rhoSL * vL_star;
+        Vector momSR = rhoSR * vR_star;
 
-        double ESL = EL + (sStar - vnL) * (rhoSL * (eL + 0.5 * (sStar - vnL)));
-        double ESR = ER + (sStar - vnR) * (rhoSR * (eR + 0.5 * (sStar - vnR)));
+        double ESL = rhoSL * (eL + (sStar - vnL) * (sStar + pL / (rhoL * (sL - vnL))));
+        double ESR = rhoSR * (eR + (sStar - vnR) * (sStar + pR / (rhoR * (sR - vnR))));
 
         if (sStar >= 0.0) {
             flux.mass = massFluxL + sL * (rhoSL - rhoL);
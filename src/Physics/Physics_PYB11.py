@@ -4,6 +4,7 @@ PYB11includes = ['"physics.hh"',
                 '"constantGridAccel.cc"',
                 '"pointSourceGravity.cc"',
                 '"nBodyGravity.cc"',
+                '"tiledNBodyGravity.cc"',
                 '"waveEquation.cc"',
                 '"hydro.hh"',
                 '"simplePhysics.cc"',
@@ -12,11 +13,16 @@ PYB11includes = ['"physics.hh"',
                 '"gridHydroHLLE.cc"',
                 '"gridHydroHLLC.cc"',
                 '"gridHydroKT.cc"',
+                '"gridHydro.cc"',
                 '"kinetics.cc"',
+                '"eventDrivenKinetics.cc"',
                 '"fem.cc"',
+                '"femThermalConduction.cc"',
                 '"thermalConduction.cc"',
                 '"phaseCoupling.cc"',
                 '"treeGravity.cc"',
+                '"particleMeshGravity.cc"',
+                '"gridSelfGravity.cc"',
                 '"reactionDiffusion.cc"']
 
 from physics import *
@@ -24,6 +30,7 @@ from constantGravity import *
 from constantGridAccel import *
 from pointSourceGravity import *
 from nBodyGravity import *
+from tiledNBodyGravity import *
 from waveEquation import *
 from hydro import *
 from simplePhysics import *
@@ -32,9 +39,14 @@ from eulerHydro import *
 from gridHydroHLLE import *
 from gridHydroHLLC import *
 from gridHydroKT import *
+from gridHydro import *
 from kinetics import *
+from eventDrivenKinetics import *
 from fem import *
+from femThermalConduction import *
 from thermalConduction import *
 from phaseCoupling import *
 from treeGravity import *
+from particleMeshGravity import *
+from gridSelfGravity import *
 from reactionDiffusion import *
\ No newline at end of file
@@ -106,8 +106,9 @@ public:
         Field<double>* soundSpeed   = nodeList->getField<double>("soundSpeed");
 
         EquationOfState* eos = this->eos;
-        eos->setPressure(pressure,rho,u);
-        eos->setSoundSpeed(soundSpeed,rho,u);
+        const int n = nodeList->size();
+        eos->setThermodynamicState(EquationOfState::data(pressure), EquationOfState::data(soundSpeed), nullptr, nullptr, nullptr,
+                                   EquationOfState::data(rho), EquationOfState::data(u), n);
     }
 
     double
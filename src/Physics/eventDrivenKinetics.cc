@@ -0,0 +1,318 @@
+// Copyright (C) 2025  Cody Raskin
+
+#include "physics.hh"
+#include "../Trees/cellList.hh"
+#include <iostream>
+#include <queue>
+#include <limits>
+
+// Event-driven hard-sphere dynamics (Alder & Wainwright 1959).
+// Each step, particles that could possibly touch within dt are found with a
+// cell list and grouped into connected clusters. Clusters can't interact
+// during the step, so they're advanced independently (and in parallel), each
+// with its own queue of predicted collision times: everything drifts
+// ballistically to the next event, the pair collides elastically, and only
+// that pair's future collisions are re-predicted.
+// A uniform acceleration is allowed since it drops out of the relative motion.
+// Clusters are cut for the fastest speed at the start of the step; if a collision
+// kicks a particle past that, the step is run again with clusters cut for the new
+// top speed, so no particle can outrun the partners it was grouped with.
+template <int dim>
+class EventDrivenKinetics : public Physics<dim> {
+protected:
+    Lin::Vector<dim> gravityVector;
+    bool periodic = false;
+    Lin::Vector<dim> boxMin, boxMax;
+    double dtmin = 1e30;
+    long long numEvents = 0;
+
+    struct Event {
+        double t;
+        int a, b;
+        int ca, cb;
+        bool operator>(const Event& other) const { return t > other.t; }
+    };
+
+    // working copies for the step. a cluster only touches its own members
+    std::vector<Lin::Vector<dim>> x, v;
+    std::vector<double> tl;
+    std::vector<int> collisions;
+    std::vector<int> adjStart, adj;
+
+public:
+    using Vector = Lin::Vector<dim>;
+    using VectorField = Field<Vector>;
+    using ScalarField = Field<double>;
+
+    EventDrivenKinetics(NodeList* nodeList, PhysicalConstants& constants, Vector& gravityVector) :
+        Physics<dim>(nodeList,constants),
+        gravityVector(gravityVector) {
+        this->template EnrollFields<double>({"mass", "radius"});
+        this->template EnrollFields<Vector>({"velocity", "position"});
+        // no state fields: this package advances the nodeList itself
+    }
+
+    EventDrivenKinetics(NodeList* nodeList, PhysicalConstants& constants, Vector& gravityVector,
+                        Vector& boxMin, Vector& boxMax) :
+        EventDrivenKinetics(nodeList, constants, gravityVector) {
+        this->periodic = true;
+        this->boxMin = boxMin;
+        this->boxMax = boxMax;
+    }
+
+    ~EventDrivenKinetics() {}
+
+    virtual void
+    PreStepInitialize() override {
+        Physics<dim>::PreStepInitialize();
+        Advance(this->stepDt);
+    }
+
+    void
+    Advance(const double dt) {
+        NodeList* nodeList = this->nodeList;
+        int numNodes = nodeList->size();
+
+        ScalarField* mass       = nodeList->getField<double>("mass");
+        ScalarField* radius     = nodeList->getField<double>("radius");
+        VectorField* position   = nodeList->getField<Vector>("position");
+        VectorField* velocity   = nodeList->getField<Vector>("velocity");
+
+        if (dt <= 0 || numNodes == 0) return;
+
+        double vmax = 0, rmax = 0;
+        #pragma omp parallel for reduction(max:vmax,rmax)
+        for (int i = 0; i < numNodes; ++i) {
+            vmax = std::max(vmax, velocity->getValue(i).magnitude());
+            rmax = std::max(rmax, radius->getValue(i));
+        }
+
+        // two spheres can only meet during the step if their gap closes at no more than 2*vmax,
+        // with speeds taken relative to the free fall. vpeak is the top speed the step reached
+        long long events = 0;
+        double vpeak = vmax;
+        do {
+            vmax = vpeak;
+            events = Cluster(dt, vmax, rmax, vpeak, mass, radius, position);
+        } while (vpeak > vmax);
+        numEvents = events;
+
+        double local_dtmin = 1e30;
+        #pragma omp parallel for reduction(min:local_dtmin)
+        for (int i = 0; i < numNodes; ++i) {
+            Vector xi = x[i];
+            if (periodic)
+                for (int d = 0; d < dim; ++d) {
+                    double L = boxMax[d] - boxMin[d];
+                    xi[d] -= L*std::floor((xi[d] - boxMin[d])/L);
+                }
+            position->setValue(i, xi);
+            velocity->setValue(i, v[i]);
+            double vi = v[i].magnitude();
+            if (vi > 0)
+                local_dtmin = std::min(local_dtmin, 0.25*radius->getValue(i)/vi);
+        }
+        double g = gravityVector.magnitude();
+        if (g > 0 && rmax > 0)
+            local_dtmin = std::min(local_dtmin, std::sqrt(0.5*rmax/g));
+        dtmin = local_dtmin;
+        this->lastDt = dt;
+    }
+
+    virtual double
+    EstimateTimestep() const override {
+        return dtmin;
+    }
+
+    virtual void
+    FinalizeStep(const State<dim>* finalState) override {
+        // nothing to copy back since the nodeList is advanced directly in PreStepInitialize
+        this->FinalChecks();
+    };
+
+    inline long long getNumEvents() const { return numEvents; }
+
+    virtual std::string name() const override { return "eventDrivenKinetics"; }
+    virtual std::string description() const override {
+        return "Event-driven hard-sphere dynamics for particles"; }
+
+protected:
+    // One attempt at the step from the nodeList's positions and velocities into x and v,
+    // with clusters cut for speeds up to vmax. Returns the number of collisions and sets
+    // vpeak to the top speed (relative to the free fall) any particle had during it.
+    long long
+    Cluster(const double dt, const double vmax, const double rmax, double& vpeak,
+            ScalarField* mass, ScalarField* radius, VectorField* position) {
+        const int numNodes = this->nodeList->size();
+        VectorField* velocity = this->nodeList->template getField<Vector>("velocity");
+        const double reach = 2.0*vmax*dt;
+        x.assign(position->getValues().begin(), position->getValues().end());
+        v.assign(velocity->getValues().begin(), velocity->getValues().end());
+        tl.assign(numNodes, 0.0);
+        collisions.assign(numNodes, 0);
+
+        adjStart.assign(numNodes + 1, 0);
+        adj.clear();
+        if (rmax > 0) {
+            const double cutoff = 2.0*rmax + reach;
+            std::unique_ptr<CellList<dim>> cells = (periodic ?
+                std::make_unique<CellList<dim>>(position, cutoff, boxMin, boxMax) :
+                std::make_unique<CellList<dim>>(position, cutoff));
+
+            // one sweep collects each close pair once, then we fan it out into a symmetric CSR list
+            std::vector<std::pair<int,int>> edges;
+            #pragma omp parallel
+            {
+                std::vector<std::pair<int,int>> local;
+                #pragma omp for nowait
+                for (int i = 0; i < numNodes; ++i) {
+                    double si = radius->getValue(i);
+                    cells->forEachNeighbor(i, cutoff, [&](int j, const Vector& rij) {
+                        if (j > i && rij.magnitude() - si - radius->getValue(j) <= reach)
+                            local.emplace_back(i, j);
+                    });
+                }
+                #pragma omp critical
+                edges.insert(edges.end(), local.begin(), local.end());
+            }
+            for (const auto& e : edges) {
+                adjStart[e.first + 1]++;
+                adjStart[e.second + 1]++;
+            }
+            for (int i = 0; i < numNodes; ++i)
+                adjStart[i + 1] += adjStart[i];
+            adj.resize(adjStart[numNodes]);
+            std::vector<int> next(adjStart.begin(), adjStart.end() - 1);
+            for (const auto& e : edges) {
+                adj[next[e.first]++]  = e.second;
+                adj[next[e.second]++] = e.first;
+            }
+        }
+
+        // clusters are the connected components of the contact graph
+        std::vector<int> parent(numNodes);
+        for (int i = 0; i < numNodes; ++i) parent[i] = i;
+        auto find = [&parent](int i) {
+            while (parent[i] != i) { parent[i] = parent[parent[i]]; i = parent[i]; }
+            return i;
+        };
+        for (int i = 0; i < numNodes; ++i)
+            for (int k = adjStart[i]; k < adjStart[i + 1]; ++k) {
+                int a = find(i), b = find(adj[k]);
+                if (a != b) parent[std::max(a, b)] = std::min(a, b);
+            }
+
+        for (int i = 0; i < numNodes; ++i) parent[i] = find(i);
+
+        std::vector<int> clusterStart(numNodes + 1, 0), members(numNodes);
+        for (int i = 0; i < numNodes; ++i) clusterStart[parent[i] + 1]++;
+        for (int i = 0; i < numNodes; ++i) clusterStart[i + 1] += clusterStart[i];
+        {
+            std::vector<int> next(clusterStart.begin(), clusterStart.end() - 1);
+            for (int i = 0; i < numNodes; ++i) members[next[parent[i]]++] = i;
+        }
+
+        long long events = 0;
+        double peak = vmax;
+        #pragma omp parallel for schedule(dynamic, 16) reduction(+:events) reduction(max:peak)
+        for (int c = 0; c < numNodes; ++c) {
+            int n = clusterStart[c + 1] - clusterStart[c];
+            if (n > 1)
+                events += AdvanceCluster(&members[clusterStart[c]], n, dt, mass, radius, peak);
+            for (int k = clusterStart[c]; k < clusterStart[c + 1]; ++k)
+                drift(members[k], dt);
+        }
+        vpeak = peak;
+        return events;
+    }
+
+    // move particle i ballistically from its local time to t
+    inline void
+    drift(int i, double t) {
+        double tau = t - tl[i];
+        x[i] += v[i]*tau + (0.5*tau*tau)*gravityVector;
+        v[i] += tau*gravityVector;
+        tl[i] = t;
+    }
+
+    inline Vector
+    displacement(const Vector& a, const Vector& b) const {
+        Vector r = a - b;
+        if (periodic)
+            for (int d = 0; d < dim; ++d) {
+                double L = boxMax[d] - boxMin[d];
+                r[d] -= L*std::round(r[d]/L);
+            }
+        return r;
+    }
+
+    // time from tnow until i and j touch, or infinity
+    double
+    collisionTime(int i, int j, double tnow, ScalarField* radius) const {
+        double ti = tnow - tl[i], tj = tnow - tl[j];
+        Vector xi = x[i] + v[i]*ti + (0.5*ti*ti)*gravityVector;
+        Vector xj = x[j] + v[j]*tj + (0.5*tj*tj)*gravityVector;
+        Vector rij = displacement(xi, xj);
+        Vector vij = v[i] - v[j] + (ti - tj)*gravityVector;
+
+        double sigma = radius->getValue(i) + radius->getValue(j);
+        double b = rij*vij;
+        if (b >= 0) return std::numeric_limits<double>::infinity();
+        double r2 = rij.mag2() - sigma*sigma;
+        if (r2 <= 0) return 0.0;    // already overlapping and approaching
+        double v2 = vij.mag2();
+        double disc = b*b - v2*r2;
+        if (disc < 0) return std::numeric_limits<double>::infinity();
+        return r2/(-b + std::sqrt(disc));  // same root as (-b - sqrt(disc))/v2, without the cancellation
+    }
+
+    void
+    predict(int i, double tnow, double dt, ScalarField* radius,
+            std::priority_queue<Event, std::vector<Event>, std::greater<Event>>& queue, bool upperOnly) {
+        for (int k = adjStart[i]; k < adjStart[i + 1]; ++k) {
+            int j = adj[k];
+            if (upperOnly && j < i) continue;
+            double tc = tnow + collisionTime(i, j, tnow, radius);
+            if (tc <= dt)
+                queue.push(Event{tc, i, j, collisions[i], collisions[j]});
+        }
+    }
+
+    long long
+    AdvanceCluster(const int* ids, int n, double dt, ScalarField* mass, ScalarField* radius, double& vpeak) {
+        std::priority_queue<Event, std::vector<Event>, std::greater<Event>> queue;
+        for (int k = 0; k < n; ++k)
+            predict(ids[k], 0.0, dt, radius, queue, true);
+
+        long long events = 0;
+        while (!queue.empty()) {
+            Event e = queue.top();
+            queue.pop();
+            if (collisions[e.a] != e.ca || collisions[e.b] != e.cb) continue;  // stale
+
+            int i = e.a, j = e.b;
+            drift(i, e.t);
+            drift(j, e.t);
+
+            Vector rij = displacement(x[i], x[j]);
+            Vector vij = v[i] - v[j];
+            double mi = mass->getValue(i);
+            double mj = mass->getValue(j);
+            double r2 = rij.mag2();
+            if (r2 > 0) {
+                Vector dv = (vij*rij/r2)*rij;
+                v[i] -= (2*mj/(mi+mj))*dv;
+                v[j] += (2*mi/(mi+mj))*dv;
+            }
+            collisions[i]++;
+            collisions[j]++;
+            events++;
+            vpeak = std::max(vpeak, std::max((v[i] - e.t*gravityVector).magnitude(),
+                                             (v[j] - e.t*gravityVector).magnitude()));
+
+            predict(i, e.t, dt, radius, queue, false);
+            predict(j, e.t, dt, radius, queue, false);
+        }
+        return events;
+    }
+};
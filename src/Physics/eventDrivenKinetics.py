@@ -0,0 +1,35 @@
+from PYB11Generator import *
+from physics import *
+
+@PYB11template("dim")
+class EventDrivenKinetics(Physics):
+    def pyinit(self,
+               nodeList="NodeList*",
+               constants="PhysicalConstants&",
+               gravityVector="Lin::Vector<%(dim)s>&"):
+        return
+    def pyinit1(self,
+               nodeList="NodeList*",
+               constants="PhysicalConstants&",
+               gravityVector="Lin::Vector<%(dim)s>&",
+               boxMin="Lin::Vector<%(dim)s>&",
+               boxMax="Lin::Vector<%(dim)s>&"):
+        return
+
+    numEvents = PYB11property("long long", getter="getNumEvents", doc="Collisions processed in the last step.")
+
+EventDrivenKinetics1d = PYB11TemplateClass(EventDrivenKinetics,
+                              template_parameters = ("1"),
+                              cppname = "EventDrivenKinetics<1>",
+                              pyname = "EventDrivenKinetics1d",
+                              docext = " (1D).")
+EventDrivenKinetics2d = PYB11TemplateClass(EventDrivenKinetics,
+                              template_parameters = ("2"),
+                              cppname = "EventDrivenKinetics<2>",
+                              pyname = "EventDrivenKinetics2d",
+                              docext = " (2D).")
+EventDrivenKinetics3d = PYB11TemplateClass(EventDrivenKinetics,
+                              template_parameters = ("3"),
+                              cppname = "EventDrivenKinetics<3>",
+                              pyname = "EventDrivenKinetics3d",
+                              docext = " (3D).")
@@ -1,27 +1,78 @@
 // Copyright (C) 2025  Cody Raskin
 
+#pragma once
+
 #include "physics.hh"
 #include "../Mesh/femesh.hh"
+#include <Eigen/Sparse>
 #include <iostream>
 
+// The global operators of a static mesh are assembled once, when the package is built:
+// the stiffness matrix K in row-major (CSR) form and the lumped mass M as a vector. A
+// package then applies them with one sparse product per evaluation instead of building
+// and scattering every element's matrices again. Call AssembleOperators after changing
+// the mesh. The mesh belongs to the caller, like a grid does, and has to outlive the package.
 template <int dim>
 class FEM : public Physics<dim> {
 protected:
     Mesh::FEMesh<dim>* mesh;
     double dtmin;
+    Eigen::SparseMatrix<double, Eigen::RowMajor> stiffness;
+    Eigen::VectorXd lumpedMass;
 public:
     using Vector = Lin::Vector<dim>;
     using VectorField = Field<Vector>;
     using ScalarField = Field<double>;
 
-    FEM(NodeList* nodeList, PhysicalConstants& constants, Mesh::FEMesh<dim>* mesh) : 
+    FEM(NodeList* nodeList, PhysicalConstants& constants, Mesh::FEMesh<dim>* mesh) :
         Physics<dim>(nodeList,constants),
         mesh(mesh) {
+        AssembleOperators();
+    }
+
+    virtual ~FEM() {}
+
+    void
+    AssembleOperators() {
+        const auto& elements  = mesh->getElements();
+        const auto& positions = mesh->getNodes();
+        const int numNodes    = positions.size();
+        const int numElements = elements.size();
+
+        // element matrices in parallel, each into its own slice of the triplets
+        std::vector<int> offset(numElements + 1, 0);
+        for (int e = 0; e < numElements; ++e) {
+            const int n = elements[e]->nodeIndices().size();
+            offset[e + 1] = offset[e] + n * n;
+        }
+        std::vector<Eigen::Triplet<double>> triplets(offset[numElements]);
+        std::vector<Eigen::VectorXd> elementMass(numElements);
+        #pragma omp parallel for
+        for (int e = 0; e < numElements; ++e) {
+            const auto& conn = elements[e]->nodeIndices();
+            const int n = conn.size();
+            Eigen::MatrixXd Ke = elements[e]->computeStiffnessMatrix(positions);
+            elementMass[e] = elements[e]->computeLumpedMassMatrix(positions);
+            for (int a = 0; a < n; ++a)
+                for (int b = 0; b < n; ++b)
+                    triplets[offset[e] + a * n + b] = Eigen::Triplet<double>(conn[a], conn[b], Ke(a, b));
+        }
+
+        stiffness.resize(numNodes, numNodes);
+        stiffness.setFromTriplets(triplets.begin(), triplets.end());   // sums shared entries
+        stiffness.makeCompressed();
+
+        lumpedMass = Eigen::VectorXd::Zero(numNodes);
+        for (int e = 0; e < numElements; ++e) {
+            const auto& conn = elements[e]->nodeIndices();
+            for (size_t a = 0; a < conn.size(); ++a)
+                lumpedMass(conn[a]) += elementMass[e](a);
+        }
     }
 
-    ~FEM() { delete mesh; }
+    inline int getNumNonZeros() const { return stiffness.nonZeros(); }
 
     virtual std::string name() const override { return "FEM"; }
     virtual std::string description() const override {
         return "FEM Physics"; }
-};
\ No newline at end of file
+};
@@ -8,6 +8,11 @@ class FEM(Physics):
                constants="PhysicalConstants&",
                mesh="Mesh::FEMesh<%(dim)s>*"):
         return
+    def AssembleOperators(self):
+        "Rebuild the stiffness matrix and lumped mass from the mesh, after it changes"
+        return "void"
+
+    numNonZeros = PYB11property("int", getter="getNumNonZeros", doc="Entries stored in the assembled stiffness matrix.")
 
 FEM1d = PYB11TemplateClass(FEM,
                               template_parameters = ("1"),
@@ -1,59 +1,39 @@
 // Copyright (C) 2025  Cody Raskin
 
-#include "physics.hh"
-#include "../Mesh/femesh.hh"
+#include "fem.cc"
+#include <stdexcept>
 
+// dT/dt = -M^-1 K T with the operators FEM assembled, one pass over the rows of K
 template <int dim>
-class FEMHeatConduction : public Physics<dim> {
-
-private:
-    FEMesh<dim>* mesh;
-
+class FEMHeatConduction : public FEM<dim> {
 public:
     using Vector = Lin::Vector<dim>;
     using ScalarField = Field<double>;
 
     FEMHeatConduction(NodeList* nodeList, PhysicalConstants& constants, Mesh::FEMesh<dim>* mesh)
-        : Physics<dim>(nodeList,constants), mesh(mesh) {
-        this->template EnrollFields<double>({"temperature","mass"});
-        this->themplate EnrollStateFields<double>({"temperature"});
+        : FEM<dim>(nodeList,constants,mesh) {
+        if ((int)mesh->getNodes().size() != nodeList->size())
+            throw std::invalid_argument("FEMHeatConduction: the mesh and the nodeList have different numbers of nodes");
+        this->template EnrollFields<double>({"temperature"});
+        this->template EnrollStateFields<double>({"temperature"});
     }
 
     void EvaluateDerivatives(const State<dim>* state, State<dim>& deriv, const double time, const double dt) override {
-        const auto& elements        = mesh->getElements();
-        const auto& connectivity    = mesh->getConnectivityMap();
-        const auto& positions       = mesh->getNodes();
-
         ScalarField* temperature = state->template getField<double>("temperature");
         ScalarField* dTdt        = deriv.template getField<double>("temperature");
 
-        ScalarField rhs("rhs", this->nodeList);
-        ScalarField mass("mass", this->nodeList);
-        rhs.setAll(0.0);
-        mass.setAll(0.0);
-
-        for (size_t e = 0; e < elements.size(); ++e) {
-            const auto& elem = *elements[e];
-            const auto& conn = connectivity[e];
-
-            Eigen::MatrixXd Ke = elem.computeStiffnessMatrix(positions);
-            Eigen::VectorXd Me = elem.computeLumpedMassMatrix(positions);
-
-            Eigen::VectorXd Te(conn.size());
-            for (size_t i = 0; i < conn.size(); ++i) {
-                Te(i) = temperature->getValue(conn[i]);
-            }
-
-            Eigen::VectorXd fe = -Ke * Te;
-
-            for (size_t i = 0; i < conn.size(); ++i) {
-                rhs[conn[i]] += fe(i);
-                mass[conn[i]] += Me(i);
-            }
-        }
-
-        for (size_t i = 0; i < dTdt->size(); ++i) {
-            dTdt->setValue(i, rhs[i] / mass[i]);
+        const auto& K       = this->stiffness;
+        const int* rowStart = K.outerIndexPtr();
+        const int* column   = K.innerIndexPtr();
+        const double* value = K.valuePtr();
+        const double* mass  = this->lumpedMass.data();
+
+        #pragma omp parallel for
+        for (int i = 0; i < K.rows(); ++i) {
+            double KT = 0.0;
+            for (int k = rowStart[i]; k < rowStart[i + 1]; ++k)
+                KT += value[k] * temperature->getValue(column[k]);
+            dTdt->setValue(i, (mass[i] > 0.0 ? -KT / mass[i] : 0.0));   // nodes in no element stay put
         }
     }
 
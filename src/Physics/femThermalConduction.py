@@ -0,0 +1,27 @@
+from PYB11Generator import *
+from fem import *
+
+@PYB11template("dim")
+class FEMHeatConduction(FEM):
+    def pyinit(self,
+               nodeList="NodeList*",
+               constants="PhysicalConstants&",
+               mesh="Mesh::FEMesh<%(dim)s>*"):
+        "The nodeList holds one node per mesh node, with the temperature on it"
+        return
+
+FEMHeatConduction1d = PYB11TemplateClass(FEMHeatConduction,
+                              template_parameters = ("1"),
+                              cppname = "FEMHeatConduction<1>",
+                              pyname = "FEMHeatConduction1d",
+                              docext = " (1D).")
+FEMHeatConduction2d = PYB11TemplateClass(FEMHeatConduction,
+                              template_parameters = ("2"),
+                              cppname = "FEMHeatConduction<2>",
+                              pyname = "FEMHeatConduction2d",
+                              docext = " (2D).")
+FEMHeatConduction3d = PYB11TemplateClass(FEMHeatConduction,
+                              template_parameters = ("3"),
+                              cppname = "FEMHeatConduction<3>",
+                              pyname = "FEMHeatConduction3d",
+                              docext = " (3D).")
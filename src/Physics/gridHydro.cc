@@ -0,0 +1,107 @@
+// Copyright (C) 2025  Cody Raskin
+
+#pragma once
+#include "gridHydroBase.hh"
+#include "gridHydroPolicies.hh"
+
+// Grid hydro with the Riemann solver and the reconstruction fixed at compile time, e.g.
+// GridHydro<2, HLLCSolver, MUSCLVanLeer>. The face flux is a non-virtual inline call in
+// GridHydroBase's face loop. Every primitive (rho, v, u, P, cs) is reconstructed
+// along the face normal from the cells on either side, which are clamped at the edge of
+// the grid. With precision "single" the sound speed is stored as floats.
+template<int dim, class RiemannSolver, class Reconstruction>
+class GridHydro : public GridHydroBase<dim> {
+public:
+    using typename GridHydroBase<dim>::Vector;
+    using typename GridHydroBase<dim>::VectorField;
+    using typename GridHydroBase<dim>::ScalarField;
+
+    static constexpr int width = Reconstruction::width;
+
+    GridHydro(NodeList* nodeList, PhysicalConstants& constants,
+              EquationOfState* eos, Mesh::Grid<dim>* grid,
+              const std::string& precision = "double")
+        : GridHydroBase<dim>(nodeList, constants, eos, grid, ParsePrecision(precision)) {}
+
+    virtual std::string name() const override {
+        return "GridHydro" + RiemannSolver::name() + Reconstruction::name(); }
+
+    virtual int StencilWidth() const override { return width; }
+
+    virtual void
+    EvaluateDerivatives(const State<dim>* initialState,
+                        State<dim>& deriv,
+                        const double time,
+                        const double dt) override {
+        this->WithScalarField("soundSpeed", [&](auto* soundSpeed) {
+            this->AccumulateFluxes(initialState, deriv, soundSpeed,
+                [this](int iL, int iR, int axis, const ScalarField& rho, const VectorField& v,
+                       const ScalarField& u, const ScalarField& p, const auto& cs) {
+                    return FaceFlux(iL, iR, axis, rho, v, u, p, cs);
+                });
+        });
+    }
+
+    virtual HLLFlux<dim>
+    computeFlux(int iL, int iR, int axis,
+                const Field<double>& rho,
+                const Field<Vector>& v,
+                const Field<double>& u,
+                const Field<double>& p,
+                const Field<double>& cs) const override {
+        return FaceFlux(iL, iR, axis, rho, v, u, p, cs);
+    }
+
+    // the 2*width cells along axis through the face between iL and iR, iL's side first
+    inline void
+    FaceStencil(int iL, int iR, int axis, int* idx) const {
+        const Mesh::Grid<dim>* grid = this->grid;
+        const int n      = (axis == 0 ? grid->nx : axis == 1 ? grid->ny : grid->nz);
+        const int stride = this->Stride(axis);
+        const int dir    = (iR > iL ? 1 : -1);
+        const int cL = grid->indexToCoordinates(iL)[axis];
+        const int cR = cL + dir;
+        for (int k = 0; k < width; ++k) {
+            int c = std::min(std::max(cL - k * dir, 0), n - 1);
+            idx[width - 1 - k] = iL + (c - cL) * stride;
+            c = std::min(std::max(cR + k * dir, 0), n - 1);
+            idx[width + k] = iR + (c - cR) * stride;
+        }
+    }
+
+    template<typename SoundSpeedField>
+    inline HLLFlux<dim>
+    FaceFlux(int iL, int iR, int axis,
+             const ScalarField& rho, const VectorField& v,
+             const ScalarField& u, const ScalarField& p, const SoundSpeedField& cs) const {
+        int idx[2 * width];
+        double q[2 * width];
+        FaceStencil(iL, iR, axis, idx);
+
+        auto reconstruct = [&](const auto& f, double& fL, double& fR) {
+            for (int k = 0; k < 2 * width; ++k) q[k] = f.getValue(idx[k]);
+            Reconstruction::faceStates(q, fL, fR);
+        };
+
+        double rhoL, rhoR, uL, uR, pL, pR, cL, cR;
+        Vector vL, vR;
+        reconstruct(rho, rhoL, rhoR);
+        reconstruct(u, uL, uR);
+        reconstruct(p, pL, pR);
+        reconstruct(cs, cL, cR);
+        for (int d = 0; d < dim; ++d) {
+            for (int k = 0; k < 2 * width; ++k) q[k] = v.getValue(idx[k])[d];
+            Reconstruction::faceStates(q, vL[d], vR[d]);
+        }
+
+        rhoL = std::max(rhoL, 1e-12);
+        rhoR = std::max(rhoR, 1e-12);
+        uL = std::max(uL, 1e-12);
+        uR = std::max(uR, 1e-12);
+        cL = std::max(cL, 0.0);
+        cR = std::max(cR, 0.0);
+
+        return RiemannSolver::template flux<dim>(rhoL, vL, uL, pL, cL,
+                                                 rhoR, vR, uR, pR, cR, axis);
+    }
+};
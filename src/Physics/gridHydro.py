@@ -0,0 +1,40 @@
+from PYB11Generator import *
+from hydro import *
+
+@PYB11template("dim", "RiemannSolver", "Reconstruction")
+class GridHydro(Hydro):
+    def pyinit(self,
+               nodeList="NodeList*",
+               constants="PhysicalConstants&",
+               eos="EquationOfState*",
+               grid="Mesh::Grid<%(dim)s>*",
+               precision=("std::string", '"double"')):
+        return
+    @PYB11cppname("getCell")
+    def getCell2d(self,i="int",j="int",fieldName="std::string"):
+        return
+    @PYB11cppname("getCellComponent")
+    def getCellComponent2d(self,i="int",j="int",component="int",fieldName="std::string"):
+        return
+    mixTolerance = PYB11property("double", getter="getMixTolerance", setter="setMixTolerance", doc="How far below 1 a cell's largest mass fraction may be for it to count as pure.")
+    lastMixedCells = PYB11property("int", getter="getLastMixedCells", doc="Mixed cells in the last EOS lookup.")
+    activeTracking = PYB11property("bool", getter="getActiveTracking", setter="setActiveTracking", doc="Only evaluate the blocks of cells near those that changed, or that this package was changing, over the last step.")
+    activityTolerance = PYB11property("double", getter="getActivityTolerance", setter="setActivityTolerance", doc="Relative change in rho, u or v below which a cell counts as unchanged.")
+    activeBlockSize = PYB11property("int", getter="getActiveBlockSize", setter="setActiveBlockSize", doc="Cells per side of an activity block.")
+    activeFraction = PYB11property("double", getter="getActiveFraction", doc="Fraction of blocks evaluated this step.")
+    precision = PYB11property("std::string", getter="getPrecision", doc="Storage of the sound speed field, double or single.")
+
+
+# Every solver/reconstruction pair, e.g. GridHydroHLLCMUSCLVanLeer2d for
+# GridHydro<2, HLLCSolver, MUSCLVanLeer>
+_solvers = ("HLLE", "HLLC", "Rusanov", "Exact")
+_reconstructions = ("PiecewiseConstant", "MUSCLMinmod", "MUSCLVanLeer", "MUSCLMC", "PPM")
+for _dim in ("1", "2", "3"):
+    for _solver in _solvers:
+        for _reconstruction in _reconstructions:
+            _pyname = "GridHydro%s%s%sd" % (_solver, _reconstruction, _dim)
+            globals()[_pyname] = PYB11TemplateClass(GridHydro,
+                                    template_parameters = (_dim, _solver + "Solver", _reconstruction),
+                                    cppname = "GridHydro<%s, %sSolver, %s>" % (_dim, _solver, _reconstruction),
+                                    pyname = _pyname,
+                                    docext = " (%s, %s, %sD)." % (_solver, _reconstruction, _dim))
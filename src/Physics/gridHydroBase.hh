@@ -3,7 +3,10 @@
 #pragma once
 #include "hydro.hh"
 #include "../Mesh/grid.hh"
+#include "../Mesh/activeBlocks.hh"
 #include <iostream>
+#include <memory>
+#include <algorithm>
 
 // Forward declaration for return type of computeFlux
 template<int dim>
@@ -21,12 +24,42 @@ protected:
     double dxmin = 1e30;
     mutable double dtmin = 1e30;
 
+    // With more than one material, each carries a mass fraction that is advected with
+    // the mass flux. A cell whose largest fraction is within mixTolerance of 1 is pure
+    // and goes to its material's batched EOS along with the rest of that material's
+    // cells; the rest are mixed and brought to a common pressure one by one.
+    std::vector<ScalarField*> massFractions;
+    std::vector<double> faceMassFlux;          // 2*dim per cell, from the last derivative
+    double mixTolerance = 1e-6;
+    int lastMixedCells = 0;
+    std::vector<int> cellBin, binStart, binOrder;
+    std::vector<double> rhoBuffer, uBuffer, pBuffer, csBuffer;
+
+    // With active tracking on, each step starts by comparing rho, u, v (and the mass
+    // fractions) with their values at the start of the last step. Cells that moved by more
+    // than activityTolerance, relative to their size, mark their block, and so do cells
+    // where this package's own derivative, in any stage of the last step, would have moved
+    // them by that much: other packages may write the same fields, and a cell held still
+    // by gravity against its pressure gradient still needs its hydro derivative. Only the
+    // inside cells of blocks near a marked one are evaluated; the rest keep zero
+    // derivatives. With a tolerance of 0 only cells that are exactly at rest, and whose
+    // own derivatives were exactly zero, are skipped, which leaves the solution unchanged.
+    bool activeTracking = false;
+    double activityTolerance = 0.0;
+    int activeBlockSize = 16;
+    std::unique_ptr<Mesh::ActiveBlocks<dim>> activity;
+    std::vector<double> lastRho, lastU, cellDt;
+    std::vector<Vector> lastV;
+    std::vector<std::vector<double>> lastX;
+    std::vector<char> driven;                  // this package moved the cell last step
+
 public:
     GridHydroBase(NodeList* nodeList,
                   PhysicalConstants& constants,
                   EquationOfState* eos,
-                  Mesh::Grid<dim>* grid)
-        : Hydro<dim>(nodeList, constants, eos), grid(grid) {
+                  Mesh::Grid<dim>* grid,
+                  Precision soundSpeedPrecision = Precision::Double)
+        : Hydro<dim>(nodeList, constants, eos, soundSpeedPrecision), grid(grid) {
         
         grid->assignPositions(nodeList);
         State<dim>* state = &this->state;
@@ -48,8 +81,106 @@ public:
 
     virtual ~GridHydroBase() {}
 
+    // index offset to the next cell along axis; every inside cell has both neighbors
+    inline int
+    Stride(const int axis) const {
+        return (axis == 0 ? 1 : axis == 1 ? grid->nx : grid->nx * grid->ny);
+    }
+
+    // how many cells to either side a face flux reads, so a cell's derivative depends on
+    // the cells within StencilWidth() of it
+    virtual int
+    StencilWidth() const { return 1; }
+
+    // the inside cells evaluated this step
+    inline const std::vector<int>&
+    EvaluatedCells() {
+        return (activity ? activity->select(insideIds) : insideIds);
+    }
+
+    inline bool
+    Evaluated(const int i) const { return !activity || activity->isActive(i); }
+
+    // whether a rate would move a value of this size by more than the activity tolerance
+    // over the step
+    inline bool
+    Drives(const double rate, const double value) const {
+        return rate > 0.0 && rate * this->stepDt >= activityTolerance * std::abs(value);
+    }
+
+    virtual void
+    PreStepInitialize() override {
+        Hydro<dim>::PreStepInitialize();
+        if (activeTracking)
+            UpdateActivity();
+    }
+
+    // Mark the blocks that changed over the last step, or that this package's own
+    // derivatives were changing. Information crosses at most StencilWidth() cells per
+    // stage, and four stages (RK4) per step, so the mask is dilated by that many cells.
+    void
+    UpdateActivity() {
+        NodeList* nodeList = this->nodeList;
+        const int n = nodeList->size();
+        auto* rho = nodeList->template getField<double>("density");
+        auto* v   = nodeList->template getField<Vector>("velocity");
+        auto* u   = nodeList->template getField<double>("specificInternalEnergy");
+
+        const bool first = !activity;
+        if (first) {
+            activity = std::make_unique<Mesh::ActiveBlocks<dim>>(grid, activeBlockSize, 4 * StencilWidth());
+            lastRho.resize(n);
+            lastU.resize(n);
+            lastV.resize(n);
+            cellDt.assign(n, 1e30);
+            driven.assign(n, 0);
+        }
+        const int M = (massFractions.size() > 1 ? massFractions.size() : 0);
+        lastX.resize(M, std::vector<double>(n));
+
+        const double tol = activityTolerance;
+        auto moved = [tol](double now, double before) {
+            return std::abs(now - before) > tol * std::max(std::abs(now), std::abs(before)); };
+        activity->update([&](int i) {
+            const double rhoi = rho->getValue(i), ui = u->getValue(i);
+            const Vector vi = v->getValue(i);
+            bool changed = first || driven[i] || moved(rhoi, lastRho[i]) || moved(ui, lastU[i]) ||
+                           (vi - lastV[i]).magnitude() > tol * std::max(vi.magnitude(), lastV[i].magnitude());
+            for (int m = 0; m < M; ++m) {
+                const double Xi = massFractions[m]->getValue(i);
+                changed = changed || moved(Xi, lastX[m][i]);
+                lastX[m][i] = Xi;
+            }
+            lastRho[i] = rhoi;
+            lastU[i]   = ui;
+            lastV[i]   = vi;
+            driven[i]  = 0;
+            return changed;
+        });
+    }
+
+    virtual int
+    AddMaterial(EquationOfState* materialEOS) override {
+        int id = Hydro<dim>::AddMaterial(materialEOS);
+        for (int k = massFractions.size(); k < this->numMaterials(); ++k) {
+            const std::string name = "massFraction" + std::to_string(k);
+            this->nodeList->template insertField<double>(name);
+            ScalarField* X = this->nodeList->template getField<double>(name);
+            this->state.template addField<double>(X);
+            massFractions.push_back(X);
+        }
+        return id;
+    }
+
     virtual void 
     ZeroTimeInitialize() override {
+        if (massFractions.size() > 1) {
+            // start every cell pure in the material it was given
+            auto* id = this->nodeList->template getField<int>("materialId");
+            for (int k = 0; k < (int)massFractions.size(); ++k)
+                for (int i = 0; i < (int)id->size(); ++i)
+                    massFractions[k]->setValue(i, id->getValue(i) == k ? 1.0 : 0.0);
+        }
         EOSLookup();
         State<dim> state = this->state;
         NodeList* nodeList = this->nodeList;
@@ -62,6 +193,21 @@ public:
                                      State<dim>& deriv,
                                      const double time,
                                      const double dt) override {
+        AccumulateFluxes(initialState, deriv, this->nodeList->template getField<double>("soundSpeed"),
+            [this](int iL, int iR, int axis, const ScalarField& rho, const VectorField& v,
+                   const ScalarField& u, const ScalarField& p, const ScalarField& cs) {
+                return this->computeFlux(iL, iR, axis, rho, v, u, p, cs);
+            });
+    }
+
+    // The finite-volume update shared by every scheme: faceFlux(iL, iR, axis, rho, v, u,
+    // p, cs) gives the flux through the face between iL and iR. It is a template argument
+    // so a scheme that knows its flux at compile time gets it inlined into the face loop.
+    // soundSpeed is the stored sound speed field, a Field<double> or a Field<float>.
+    template<typename SoundSpeedField, typename FluxFunction>
+    void
+    AccumulateFluxes(const State<dim>* initialState, State<dim>& deriv,
+                     const SoundSpeedField* soundSpeed, FluxFunction&& faceFlux) {
         NodeList* nodeList = this->nodeList;
 
         auto* rho = initialState->template getField<double>("density");
@@ -73,13 +219,16 @@ public:
         auto* dudt   = deriv.template getField<double>("specificInternalEnergy");
 
         auto* pressure   = nodeList->getField<double>("pressure");
-        auto* soundSpeed = nodeList->getField<double>("soundSpeed");
 
         double local_dtmin = 1e30;
+        const bool multiMaterial = massFractions.size() > 1;
+        if (multiMaterial)
+            faceMassFlux.assign(2 * dim * nodeList->size(), 0.0);
 
+        const std::vector<int>& cells = EvaluatedCells();
         #pragma omp parallel for reduction(min:local_dtmin)
-        for (int h = 0; h < insideIds.size(); ++h) {
-            int i = insideIds[h];
+        for (int h = 0; h < cells.size(); ++h) {
+            int i = cells[h];
             Vector vi = v->getValue(i);
             double rhoi = rho->getValue(i);
             double ui = u->getValue(i);
@@ -102,11 +251,9 @@ public:
             Vector net_mom_flux = Vector::zero();
             double net_E_flux = 0.0;
 
-            auto neighbors = grid->getNeighboringCells(i);
-
             for (int k = 0; k < dim; ++k) {
-                int jL = neighbors[2 * k];
-                int jR = neighbors[2 * k + 1];
+                int jL = i - Stride(k);
+                int jR = i + Stride(k);
 
                 // Check validity of jL and jR
                 for (int q : {jL, jR, i}) {
@@ -122,10 +269,14 @@ public:
                 }
 
 
-                auto flux_L = this->computeFlux(jL, i, k, *rho, *v, *u, *pressure, *soundSpeed);
-                auto flux_R = this->computeFlux(i, jR, k, *rho, *v, *u, *pressure, *soundSpeed);
+                auto flux_L = faceFlux(jL, i, k, *rho, *v, *u, *pressure, *soundSpeed);
+                auto flux_R = faceFlux(i, jR, k, *rho, *v, *u, *pressure, *soundSpeed);
 
                 double dx = grid->spacing(k);
+                if (multiMaterial) {
+                    faceMassFlux[2 * dim * i + 2 * k]     = flux_L.mass;
+                    faceMassFlux[2 * dim * i + 2 * k + 1] = flux_R.mass;
+                }
                 net_rho_flux += (flux_L.mass - flux_R.mass) / dx;
                 net_mom_flux += (flux_L.momentum - flux_R.momentum) / dx;
                 net_E_flux   += (flux_L.energy - flux_R.energy) / dx;
@@ -133,15 +284,61 @@ public:
 
             drhodt->setValue(i, net_rho_flux);
             Vector dvi = (net_mom_flux - vi * net_rho_flux) / rhoi;
-            double dui = (net_E_flux - vi.dot(net_mom_flux) - 0.5 * vi.mag2() * net_rho_flux) / rhoi;
+            double dui = (net_E_flux - vi.dot(net_mom_flux) + (0.5 * vi.mag2() - ui) * net_rho_flux) / rhoi;
 
             dvdt->setValue(i, dvi);
             dudt->setValue(i, dui);
 
-            local_dtmin = std::min(local_dtmin, 0.1 * dxmin / (ci+vi.magnitude()));
+            const double dti = 0.1 * dxmin / (ci+vi.magnitude());
+            local_dtmin = std::min(local_dtmin, dti);
+            if (activity) {
+                cellDt[i] = dti;
+                if (Drives(std::abs(net_rho_flux), rhoi) || Drives(std::abs(dui), ui) ||
+                    Drives(dvi.magnitude(), vi.magnitude()))
+                    driven[i] = 1;
+            }
         }
 
+        // a skipped cell still limits the step, by what it asked for when it was last evaluated
+        if (activity) {
+            #pragma omp parallel for reduction(min:local_dtmin)
+            for (int h = 0; h < insideIds.size(); ++h)
+                local_dtmin = std::min(local_dtmin, cellDt[insideIds[h]]);
+        }
         dtmin = local_dtmin;
+
+        if (multiMaterial)
+            AdvectMassFractions(initialState, deriv, rho, drhodt);
+    }
+
+    // d(rho X)/dt from the upwind X on each face's mass flux, as dX/dt
+    void
+    AdvectMassFractions(const State<dim>* initialState, State<dim>& deriv,
+                        const ScalarField* rho, const ScalarField* drhodt) {
+        for (int m = 0; m < (int)massFractions.size(); ++m) {
+            const std::string name = massFractions[m]->getNameString();
+            auto* X    = initialState->template getField<double>(name);
+            auto* dXdt = deriv.template getField<double>(name);
+
+            const std::vector<int>& cells = EvaluatedCells();
+            #pragma omp parallel for
+            for (int h = 0; h < (int)cells.size(); ++h) {
+                int i = cells[h];
+                double Xi = X->getValue(i);
+                double net = 0.0;
+                for (int k = 0; k < dim; ++k) {
+                    double FL = faceMassFlux[2 * dim * i + 2 * k];
+                    double FR = faceMassFlux[2 * dim * i + 2 * k + 1];
+                    double XL = (FL > 0.0 ? X->getValue(i - Stride(k)) : Xi);
+                    double XR = (FR > 0.0 ? Xi : X->getValue(i + Stride(k)));
+                    net += (FL * XL - FR * XR) / grid->spacing(k);
+                }
+                double rhoi = std::max(rho->getValue(i), 1e-12);
+                double dXi  = (net - Xi * drhodt->getValue(i)) / rhoi;
+                dXdt->setValue(i, dXi);
+                if (activity && Drives(std::abs(dXi), Xi)) driven[i] = 1;
+            }
+        }
     }
 
     virtual double 
@@ -165,26 +362,199 @@ public:
             velocity->setValue(i,fvelocity->getValue(i));
             u->setValue(i, std::max(fu->getValue(i), 1e-12));
         }
+
+        if (massFractions.size() > 1)
+            NormalizeMassFractions(finalState);
         
         EOSLookup();
     }
 
+    // clip to [0,1], renormalize, and label each cell with its dominant material
+    void
+    NormalizeMassFractions(const State<dim>* finalState) {
+        const int M = massFractions.size();
+        const int n = this->nodeList->size();
+        auto* id = this->nodeList->template getField<int>("materialId");
+        std::vector<const ScalarField*> fX(M);
+        for (int m = 0; m < M; ++m)
+            fX[m] = finalState->template getField<double>(massFractions[m]->getNameString());
+
+        #pragma omp parallel for
+        for (int i = 0; i < n; ++i) {
+            double sum = 0.0, best = -1.0;
+            int bestId = 0;
+            for (int m = 0; m < M; ++m) {
+                double Xm = std::min(std::max(fX[m]->getValue(i), 0.0), 1.0);
+                massFractions[m]->setValue(i, Xm);
+                sum += Xm;
+                if (Xm > best) { best = Xm; bestId = m; }
+            }
+            for (int m = 0; m < M; ++m)
+                massFractions[m]->setValue(i, (sum > 0.0 ? massFractions[m]->getValue(i) / sum : (m == bestId)));
+            id->setValue(i, bestId);
+        }
+    }
+
     virtual void 
     EOSLookup() {
         NodeList* nodeList = this->nodeList;
         auto* rho = nodeList->getField<double>("density");
         auto* u = nodeList->getField<double>("specificInternalEnergy");
         auto* pressure = nodeList->getField<double>("pressure");
-        auto* cs = nodeList->getField<double>("soundSpeed");
-        this->eos->setPressure(pressure, rho, u);
-        this->eos->setSoundSpeed(cs, rho, u);
+        this->WithScalarField("soundSpeed", [&](auto* cs) {
+            if (massFractions.size() < 2)
+                SingleMaterialEOSLookup(rho, u, pressure, cs);
+            else
+                MaterialEOSLookup(rho, u, pressure, cs);
+        });
+    }
+
+    void
+    SingleMaterialEOSLookup(ScalarField* rho, ScalarField* u, ScalarField* pressure, ScalarField* cs) {
+        this->eos->setThermodynamicState(EquationOfState::data(pressure), EquationOfState::data(cs), nullptr, nullptr, nullptr,
+                                         EquationOfState::data(rho), EquationOfState::data(u), rho->size());
     }
 
+    // a single precision sound speed goes through a double buffer
+    void
+    SingleMaterialEOSLookup(ScalarField* rho, ScalarField* u, ScalarField* pressure, Field<float>* cs) {
+        const int n = rho->size();
+        csBuffer.resize(n);
+        this->eos->setThermodynamicState(EquationOfState::data(pressure), csBuffer.data(), nullptr, nullptr, nullptr,
+                                         EquationOfState::data(rho), EquationOfState::data(u), n);
+        #pragma omp parallel for
+        for (int i = 0; i < n; ++i)
+            cs->setValue(i, csBuffer[i]);
+    }
+
+    // Bin the cells by material with a counting sort (mixed cells in a last bin), then
+    // make one batched EOS call per material on its gathered pure cells
+    template<typename SoundSpeedField>
+    void
+    MaterialEOSLookup(ScalarField* rho, ScalarField* u, ScalarField* pressure, SoundSpeedField* cs) {
+        const int M = massFractions.size();
+        const int n = this->nodeList->size();
+        cellBin.resize(n);
+        #pragma omp parallel for
+        for (int i = 0; i < n; ++i) {
+            int bin = M;
+            for (int m = 0; m < M; ++m)
+                if (massFractions[m]->getValue(i) >= 1.0 - mixTolerance) { bin = m; break; }
+            cellBin[i] = bin;
+        }
+
+        binStart.assign(M + 2, 0);
+        for (int i = 0; i < n; ++i) binStart[cellBin[i] + 1]++;
+        for (int b = 0; b <= M; ++b) binStart[b + 1] += binStart[b];
+        binOrder.resize(n);
+        std::vector<int> fill(binStart.begin(), binStart.end() - 1);
+        for (int i = 0; i < n; ++i) binOrder[fill[cellBin[i]]++] = i;
+
+        rhoBuffer.resize(n);
+        uBuffer.resize(n);
+        pBuffer.resize(n);
+        csBuffer.resize(n);
+        const int numPure = binStart[M];
+        #pragma omp parallel for
+        for (int k = 0; k < numPure; ++k) {
+            rhoBuffer[k] = rho->getValue(binOrder[k]);
+            uBuffer[k]   = u->getValue(binOrder[k]);
+        }
+        for (int m = 0; m < M; ++m) {
+            const int start = binStart[m], count = binStart[m + 1] - start;
+            if (count == 0) continue;
+            this->materials[m]->setThermodynamicState(&pBuffer[start], &csBuffer[start], nullptr, nullptr, nullptr,
+                                                      &rhoBuffer[start], &uBuffer[start], count);
+        }
+        #pragma omp parallel for
+        for (int k = 0; k < numPure; ++k) {
+            pressure->setValue(binOrder[k], pBuffer[k]);
+            cs->setValue(binOrder[k], csBuffer[k]);
+        }
+
+        lastMixedCells = n - numPure;
+        #pragma omp parallel
+        {
+            std::vector<double> scratch(5 * M);   // one per thread, reused for every mixed cell
+            #pragma omp for schedule(dynamic, 16)
+            for (int k = numPure; k < n; ++k) {
+                const int i = binOrder[k];
+                double P, c;
+                EquilibratePressure(i, rho->getValue(i), u->getValue(i), P, c, scratch.data());
+                pressure->setValue(i, P);
+                cs->setValue(i, c);
+            }
+        }
+    }
+
+    // Split a mixed cell's volume between its materials, all at the cell's specific
+    // energy, until they share one pressure: each step moves volume toward the
+    // materials above the mean, weighted by their stiffness rho_m c_m^2 / alpha_m.
+    // The mixture sound speed is Wood's, 1/(rho c^2) = sum alpha_m / (rho_m c_m^2).
+    // scratch holds 5 doubles per material and belongs to the calling thread.
+    void
+    EquilibratePressure(const int i, double rho, double u, double& P, double& cs, double* scratch) const {
+        const int M = massFractions.size();
+        double *X = scratch, *alpha = X + M, *Pm = alpha + M, *K = Pm + M, *rhoC2 = K + M;
+        std::fill(Pm, Pm + 3 * M, 0.0);
+        for (int m = 0; m < M; ++m) {
+            X[m] = massFractions[m]->getValue(i);
+            alpha[m] = X[m];
+        }
+
+        P = 0.0;
+        for (int iter = 0; iter < 20; ++iter) {
+            double sumPK = 0.0, sumInvK = 0.0;
+            for (int m = 0; m < M; ++m) {
+                if (X[m] <= 0.0) continue;
+                double rhom = X[m] * rho / alpha[m], cm;
+                this->materials[m]->setPressure(&Pm[m], &rhom, &u);
+                this->materials[m]->setSoundSpeed(&cm, &rhom, &u);
+                rhoC2[m] = std::max(rhom * cm * cm, 1e-300);
+                K[m] = rhoC2[m] / alpha[m];
+                sumPK += Pm[m] / K[m];
+                sumInvK += 1.0 / K[m];
+            }
+            P = sumPK / sumInvK;
+
+            double worst = 0.0, sumAlpha = 0.0;
+            for (int m = 0; m < M; ++m) {
+                if (X[m] <= 0.0) continue;
+                worst = std::max(worst, std::abs(Pm[m] - P));
+                double da = (Pm[m] - P) / K[m];
+                alpha[m] = std::max(alpha[m] + da, 0.1 * alpha[m]);
+                sumAlpha += alpha[m];
+            }
+            for (int m = 0; m < M; ++m) alpha[m] /= sumAlpha;
+            if (worst <= 1e-8 * std::abs(P)) break;
+        }
+
+        double compliance = 0.0;
+        for (int m = 0; m < M; ++m)
+            if (X[m] > 0.0) compliance += alpha[m] / rhoC2[m];
+        cs = std::sqrt(1.0 / (rho * compliance));
+    }
+
+    inline double getMixTolerance() const { return mixTolerance; }
+    inline void setMixTolerance(const double value) { mixTolerance = value; }
+    inline int getLastMixedCells() const { return lastMixedCells; }
+    inline bool getActiveTracking() const { return activeTracking; }
+    inline void setActiveTracking(const bool value) { activeTracking = value; activity.reset(); }
+    inline double getActivityTolerance() const { return activityTolerance; }
+    inline void setActivityTolerance(const double value) { activityTolerance = value; }
+    inline int getActiveBlockSize() const { return activeBlockSize; }
+    inline void setActiveBlockSize(const int value) { activeBlockSize = std::max(value, 1); activity.reset(); }
+    inline double getActiveFraction() const {
+        return (activity ? (double)activity->numActiveBlocks() / activity->numBlocks() : 1.0); }
+    inline std::string getPrecision() const {
+        return (this->nodeList->template getField<float>("soundSpeed") ? "single" : "double"); }
+
     virtual double 
     getCell(int i, int j, const std::string& fieldName = "pressure") const {
         int idx = grid->index(i, j, 0);
-        ScalarField* field = this->nodeList->template getField<double>(fieldName);
-        return field->getValue(idx);
+        double value;
+        this->WithScalarField(fieldName, [&](auto* field) { value = field->getValue(idx); });
+        return value;
     }
 
     virtual double 
@@ -15,6 +15,12 @@ class GridHydroHLLE(Hydro):
     @PYB11cppname("getCellComponent")
     def getCellComponent2d(self,i="int",j="int",component="int",fieldName="std::string"):
         return
+    mixTolerance = PYB11property("double", getter="getMixTolerance", setter="setMixTolerance", doc="How far below 1 a cell's largest mass fraction may be for it to count as pure.")
+    lastMixedCells = PYB11property("int", getter="getLastMixedCells", doc="Mixed cells in the last EOS lookup.")
+    activeTracking = PYB11property("bool", getter="getActiveTracking", setter="setActiveTracking", doc="Only evaluate the blocks of cells near those that changed, or that this package was changing, over the last step.")
+    activityTolerance = PYB11property("double", getter="getActivityTolerance", setter="setActivityTolerance", doc="Relative change in rho, u or v below which a cell counts as unchanged.")
+    activeBlockSize = PYB11property("int", getter="getActiveBlockSize", setter="setActiveBlockSize", doc="Cells per side of an activity block.")
+    activeFraction = PYB11property("double", getter="getActiveFraction", doc="Fraction of blocks evaluated this step.")
 
 
 GridHydroHLLE1d = PYB11TemplateClass(GridHydroHLLE,
@@ -6,6 +6,10 @@
 #include "HLL.cc"
 
 
+// Each stage runs in three passes: every cell is reconstructed once per axis into its
+// two face states (with their conserved variables and physical fluxes), every face
+// flux is computed once from the states on either side, and GridHydroBase then
+// differences the stored face fluxes.
 template<int dim>
 class GridHydroKT : public GridHydroBase<dim> {
 public:
@@ -19,7 +23,9 @@ public:
 
     virtual std::string name() const override { return "GridHydroKT"; }
 
-    struct 
+    virtual int StencilWidth() const override { return 2; }
+
+    struct
     ConsVars {
         double rho;
         Vector mom;
@@ -34,18 +40,43 @@ public:
         }
     };
 
-    inline double 
+    // a cell's primitives extrapolated to one of its faces along axis, as conserved
+    // variables and the physical flux through that face
+    struct
+    FaceState {
+        ConsVars q;
+        HLLFlux<dim> F;
+        double vn, c;
+
+        static FaceState fromPrimitive(double rho, Vector v, double u, double p, double c, int axis) {
+            FaceState s;
+            s.q  = ConsVars::fromPrimitive(rho, v, u);
+            s.vn = v[axis];
+            s.c  = c;
+            s.F.mass     = s.q.rho * s.vn;
+            s.F.momentum = s.q.mom * s.vn; s.F.momentum[axis] += p;
+            s.F.energy   = (s.q.E + p) * s.vn;
+            return s;
+        }
+    };
+
+protected:
+    std::vector<FaceState> minusFaces, plusFaces;   // dim per cell
+    std::vector<HLLFlux<dim>> faceFluxes;           // dim per cell, through its face on the + side
+
+public:
+    inline double
     minmod(double a, double b) const {
         if (a * b <= 0.0) return 0.0;
         return (std::abs(a) < std::abs(b)) ? a : b;
     }
 
-    inline double 
+    inline double
     muscl_slope(double uL, double uC, double uR) const {
         return 0.5 * minmod(uC - uL, uR - uC);
     }
 
-    inline double 
+    inline double
     vanleer_slope(double uL, double uC, double uR) const {
         double deltaL = uC - uL;
         double deltaR = uR - uC;
@@ -55,98 +86,127 @@ public:
         return (2.0 * deltaL * deltaR) / (deltaL + deltaR);
     }
 
-    template<typename T>
-    T slopeLimitedValue(const Field<T>& field, int idx, int axis) const {
-        auto neighbors = this->grid->getNeighboringCells(idx);
-        int iL = neighbors[2 * axis];
-        int iR = neighbors[2 * axis + 1];
-
-        if (iL < 0 || iR < 0) return T();
-
-        T uL = field.getValue(iL);
-        T uC = field.getValue(idx);
-        T uR = field.getValue(iR);
+    inline int
+    AxisSize(const int axis) const {
+        return (axis == 0 ? this->grid->nx : axis == 1 ? this->grid->ny : this->grid->nz);
+    }
 
-        if constexpr (std::is_same<T, double>::value) {
-            return vanleer_slope(uL, uC, uR);
-        } else {
-            T slope;
+    // van Leer limited reconstruction of cell i to its faces along axis; a cell on the
+    // edge of the grid is left flat
+    inline void
+    Reconstruct(int i, int axis, const std::array<int, 3>& coords,
+                const Field<double>& rho, const Field<Vector>& v, const Field<double>& u,
+                const Field<double>& p, const Field<double>& cs,
+                FaceState& minus, FaceState& plus) const {
+        double rho0 = rho.getValue(i);
+        Vector v0   = v.getValue(i);
+        double u0   = u.getValue(i);
+        double p0   = p.getValue(i);
+        double c0   = cs.getValue(i);
+
+        double drho = 0.0, du = 0.0, dp = 0.0, dc = 0.0;
+        Vector dv   = Vector::zero();
+        if (coords[axis] > 0 && coords[axis] < AxisSize(axis) - 1) {
+            const int iL = i - this->Stride(axis), iR = i + this->Stride(axis);
+            drho = vanleer_slope(rho.getValue(iL), rho0, rho.getValue(iR));
+            du   = vanleer_slope(u.getValue(iL), u0, u.getValue(iR));
+            dp   = vanleer_slope(p.getValue(iL), p0, p.getValue(iR));
+            dc   = vanleer_slope(cs.getValue(iL), c0, cs.getValue(iR));
+            Vector vL = v.getValue(iL), vR = v.getValue(iR);
             for (int d = 0; d < dim; ++d)
-                slope[d] = vanleer_slope(uL[d], uC[d], uR[d]);
-            return slope;
+                dv[d] = vanleer_slope(vL[d], v0[d], vR[d]);
         }
+
+        minus = FaceState::fromPrimitive(rho0 - 0.5 * drho, v0 - 0.5 * dv, u0 - 0.5 * du,
+                                         p0 - 0.5 * dp, c0 - 0.5 * dc, axis);
+        plus  = FaceState::fromPrimitive(rho0 + 0.5 * drho, v0 + 0.5 * dv, u0 + 0.5 * du,
+                                         p0 + 0.5 * dp, c0 + 0.5 * dc, axis);
     }
 
-    virtual HLLFlux<dim> 
-    computeFlux(int iL, int iR, int axis,
-                const Field<double>& rho,
-                const Field<Vector>& v,
-                const Field<double>& u,
-                const Field<double>& p,
-                const Field<double>& cs) const override {
-        double dx = this->grid->spacing(axis);
-
-        // Cell-centered values
-        double rho0L= rho.getValue(iL), rho0R = rho.getValue(iR);
-        Vector v0L  = v.getValue(iL), v0R = v.getValue(iR);
-        double u0L  = u.getValue(iL), u0R = u.getValue(iR);
-        double p0L  = p.getValue(iL), p0R = p.getValue(iR);
-        double c0L  = cs.getValue(iL), c0R = cs.getValue(iR);
-
-        // Slopes
-        double drhoL    = slopeLimitedValue(rho, iL, axis);
-        double drhoR    = slopeLimitedValue(rho, iR, axis);
-        Vector dvL      = slopeLimitedValue(v, iL, axis);
-        Vector dvR      = slopeLimitedValue(v, iR, axis);
-        double duL      = slopeLimitedValue(u, iL, axis);
-        double duR      = slopeLimitedValue(u, iR, axis);
-        double dpL      = slopeLimitedValue(p, iL, axis);
-        double dpR      = slopeLimitedValue(p, iR, axis);
-        double dcL      = slopeLimitedValue(cs, iL, axis);
-        double dcR      = slopeLimitedValue(cs, iR, axis);
-
-        // Reconstructed interface values
-        double rhoL = rho0L + 0.5 * drhoL;
-        double rhoR = rho0R - 0.5 * drhoR;
-        Vector vL   = v0L + 0.5 * dvL;
-        Vector vR   = v0R - 0.5 * dvR;
-        double uL   = u0L + 0.5 * duL;
-        double uR   = u0R - 0.5 * duR;
-        double pL   = p0L + 0.5 * dpL;
-        double pR   = p0R - 0.5 * dpR;
-        double cL   = c0L + 0.5 * dcL;
-        double cR   = c0R - 0.5 * dcR;
-
-        double vnL  = vL[axis], vnR = vR[axis];
-
-        ConsVars qL = ConsVars::fromPrimitive(rhoL, vL, uL);
-        ConsVars qR = ConsVars::fromPrimitive(rhoR, vR, uR);
-
-        HLLFlux<dim> FL, FR;
-        FL.mass     = qL.rho * vnL;
-        FL.momentum = qL.mom * vnL; FL.momentum[axis] += pL;
-        FL.energy   = (qL.E + pL) * vnL;
-
-        FR.mass     = qR.rho * vnR;
-        FR.momentum = qR.mom * vnR; FR.momentum[axis] += pR;
-        FR.energy   = (qR.E + pR) * vnR;
-
-        double aPlus = std::max({0.0, vnL + cL, vnR + cR});
-        double aMinus = std::min({0.0, vnL - cL, vnR - cR});
+    // central-upwind flux from the + face state of the left cell and the - face state
+    // of the right cell
+    static inline HLLFlux<dim>
+    KTFlux(const FaceState& L, const FaceState& R) {
+        double aPlus = std::max({0.0, L.vn + L.c, R.vn + R.c});
+        double aMinus = std::min({0.0, L.vn - L.c, R.vn - R.c});
 
         double denom = aPlus - aMinus;
         HLLFlux<dim> flux;
 
         if (std::abs(denom) < 1e-12) {
-            flux.mass       = 0.5 * (FL.mass + FR.mass);
-            flux.momentum   = 0.5 * (FL.momentum + FR.momentum);
-            flux.energy     = 0.5 * (FL.energy + FR.energy);
+            flux.mass       = 0.5 * (L.F.mass + R.F.mass);
+            flux.momentum   = 0.5 * (L.F.momentum + R.F.momentum);
+            flux.energy     = 0.5 * (L.F.energy + R.F.energy);
             return flux;
         }
 
-        flux.mass       = (aPlus*FL.mass - aMinus*FR.mass + aPlus*aMinus * (qR.rho - qL.rho)) / denom;
-        flux.momentum   = (FL.momentum*aPlus - FR.momentum*aMinus + aPlus*aMinus * (qR.mom - qL.mom)) / denom;
-        flux.energy     = (aPlus*FL.energy - aMinus*FR.energy + aPlus*aMinus * (qR.E - qL.E)) / denom;
+        flux.mass       = (aPlus*L.F.mass - aMinus*R.F.mass + aPlus*aMinus * (R.q.rho - L.q.rho)) / denom;
+        flux.momentum   = (L.F.momentum*aPlus - R.F.momentum*aMinus + aPlus*aMinus * (R.q.mom - L.q.mom)) / denom;
+        flux.energy     = (aPlus*L.F.energy - aMinus*R.F.energy + aPlus*aMinus * (R.q.E - L.q.E)) / denom;
         return flux;
     }
+
+    virtual void
+    EvaluateDerivatives(const State<dim>* initialState,
+                        State<dim>& deriv,
+                        const double time,
+                        const double dt) override {
+        NodeList* nodeList = this->nodeList;
+        const int n = nodeList->size();
+
+        auto* rho = initialState->template getField<double>("density");
+        auto* v   = initialState->template getField<Vector>("velocity");
+        auto* u   = initialState->template getField<double>("specificInternalEnergy");
+        auto* p   = nodeList->template getField<double>("pressure");
+        auto* cs  = nodeList->template getField<double>("soundSpeed");
+
+        minusFaces.resize(n * dim);
+        plusFaces.resize(n * dim);
+        faceFluxes.resize(n * dim);
+
+        // with active tracking, only the faces of evaluated cells are needed
+        auto faceNeeded = [this](int iL, int axis) {
+            return this->Evaluated(iL) || this->Evaluated(iL + this->Stride(axis)); };
+
+        #pragma omp parallel for
+        for (int i = 0; i < n; ++i) {
+            const std::array<int, 3> coords = this->grid->indexToCoordinates(i);
+            if (this->activity) {
+                bool needed = this->Evaluated(i);
+                for (int k = 0; k < dim && !needed; ++k)
+                    needed = (coords[k] > 0 && this->Evaluated(i - this->Stride(k))) ||
+                             (coords[k] < AxisSize(k) - 1 && this->Evaluated(i + this->Stride(k)));
+                if (!needed) continue;
+            }
+            for (int k = 0; k < dim; ++k)
+                Reconstruct(i, k, coords, *rho, *v, *u, *p, *cs, minusFaces[i * dim + k], plusFaces[i * dim + k]);
+        }
+
+        #pragma omp parallel for
+        for (int i = 0; i < n; ++i) {
+            const std::array<int, 3> coords = this->grid->indexToCoordinates(i);
+            for (int k = 0; k < dim; ++k)
+                if (coords[k] < AxisSize(k) - 1 && (!this->activity || faceNeeded(i, k)))
+                    faceFluxes[i * dim + k] = KTFlux(plusFaces[i * dim + k], minusFaces[(i + this->Stride(k)) * dim + k]);
+        }
+
+        this->AccumulateFluxes(initialState, deriv, cs,
+            [this](int iL, int iR, int axis, const ScalarField&, const VectorField&,
+                   const ScalarField&, const ScalarField&, const ScalarField&) {
+                return faceFluxes[iL * dim + axis];
+            });
+    }
+
+    virtual HLLFlux<dim>
+    computeFlux(int iL, int iR, int axis,
+                const Field<double>& rho,
+                const Field<Vector>& v,
+                const Field<double>& u,
+                const Field<double>& p,
+                const Field<double>& cs) const override {
+        FaceState minusL, plusL, minusR, plusR;
+        Reconstruct(iL, axis, this->grid->indexToCoordinates(iL), rho, v, u, p, cs, minusL, plusL);
+        Reconstruct(iR, axis, this->grid->indexToCoordinates(iR), rho, v, u, p, cs, minusR, plusR);
+        return KTFlux(plusL, minusR);
+    }
 };
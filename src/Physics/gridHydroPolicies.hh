@@ -0,0 +1,277 @@
+// Copyright (C) 2025  Cody Raskin
+
+#pragma once
+#include "HLL.cc"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+// Compile-time policies for GridHydro<dim, RiemannSolver, Reconstruction>.
+//
+// A Reconstruction turns the 2*width cell values straddling a face, q[0..2*width-1]
+// with the face between q[width-1] and q[width], into the left and right face states.
+// A RiemannSolver turns those primitive states into the face flux. Both are structs of
+// static inline functions, so the face loop they are plugged into has no virtual calls.
+
+// ---- Slope limiters ----
+
+struct MinmodLimiter {
+    static inline double
+    slope(double a, double b) {
+        if (a * b <= 0.0) return 0.0;
+        return (std::abs(a) < std::abs(b)) ? a : b;
+    }
+    static std::string name() { return "Minmod"; }
+};
+
+struct VanLeerLimiter {
+    static inline double
+    slope(double a, double b) {
+        if (a * b <= 0.0) return 0.0;
+        return 2.0 * a * b / (a + b);
+    }
+    static std::string name() { return "VanLeer"; }
+};
+
+// monotonized central
+struct MCLimiter {
+    static inline double
+    slope(double a, double b) {
+        if (a * b <= 0.0) return 0.0;
+        double s = std::min({2.0 * std::abs(a), 2.0 * std::abs(b), 0.5 * std::abs(a + b)});
+        return (a > 0.0 ? s : -s);
+    }
+    static std::string name() { return "MC"; }
+};
+
+// ---- Reconstructions ----
+
+struct PiecewiseConstant {
+    static constexpr int width = 1;
+
+    static inline void
+    faceStates(const double* q, double& qL, double& qR) {
+        qL = q[0];
+        qR = q[1];
+    }
+    static std::string name() { return "PiecewiseConstant"; }
+};
+
+// piecewise linear with a limited slope
+template<class Limiter>
+struct MUSCL {
+    static constexpr int width = 2;
+
+    static inline void
+    faceStates(const double* q, double& qL, double& qR) {
+        qL = q[1] + 0.5 * Limiter::slope(q[1] - q[0], q[2] - q[1]);
+        qR = q[2] - 0.5 * Limiter::slope(q[2] - q[1], q[3] - q[2]);
+    }
+    static std::string name() { return "MUSCL" + Limiter::name(); }
+};
+
+using MUSCLMinmod  = MUSCL<MinmodLimiter>;
+using MUSCLVanLeer = MUSCL<VanLeerLimiter>;
+using MUSCLMC      = MUSCL<MCLimiter>;
+
+// Colella & Woodward (1984) piecewise parabolic, with the edge values from the
+// fourth-order interpolant clipped to their neighbors and the parabola then made
+// monotone inside the cell
+struct PPM {
+    static constexpr int width = 3;
+
+    static inline double
+    edgeValue(double qm1, double q0, double qp1, double qp2) {
+        double a = (7.0 * (q0 + qp1) - (qm1 + qp2)) / 12.0;
+        return std::min(std::max(a, std::min(q0, qp1)), std::max(q0, qp1));
+    }
+
+    // left and right edge values of the cell q[2] of q[0..4]
+    static inline void
+    cellEdges(const double* q, double& aMinus, double& aPlus) {
+        const double q0 = q[2];
+        aMinus = edgeValue(q[0], q[1], q[2], q[3]);
+        aPlus  = edgeValue(q[1], q[2], q[3], q[4]);
+        if ((aPlus - q0) * (q0 - aMinus) <= 0.0) {
+            aMinus = aPlus = q0;
+            return;
+        }
+        double d = aPlus - aMinus;
+        double m6 = 6.0 * (q0 - 0.5 * (aMinus + aPlus));
+        if (d * m6 > d * d)       aMinus = 3.0 * q0 - 2.0 * aPlus;
+        else if (-d * d > d * m6) aPlus  = 3.0 * q0 - 2.0 * aMinus;
+    }
+
+    static inline void
+    faceStates(const double* q, double& qL, double& qR) {
+        double aMinus, aPlus;
+        cellEdges(q, aMinus, aPlus);       // cell q[2], left of the face
+        qL = aPlus;
+        cellEdges(q + 1, aMinus, aPlus);   // cell q[3], right of the face
+        qR = aMinus;
+    }
+    static std::string name() { return "PPM"; }
+};
+
+// ---- Riemann solvers ----
+
+struct HLLESolver {
+    template<int dim>
+    static inline HLLFlux<dim>
+    flux(double rhoL, const Lin::Vector<dim>& vL, double uL, double pL, double cL,
+         double rhoR, const Lin::Vector<dim>& vR, double uR, double pR, double cR, int axis) {
+        return computeHLLEFluxFromStates<dim>(rhoL, vL, uL, pL, cL, rhoR, vR, uR, pR, cR, axis);
+    }
+    static std::string name() { return "HLLE"; }
+};
+
+struct HLLCSolver {
+    template<int dim>
+    static inline HLLFlux<dim>
+    flux(double rhoL, const Lin::Vector<dim>& vL, double uL, double pL, double cL,
+         double rhoR, const Lin::Vector<dim>& vR, double uR, double pR, double cR, int axis) {
+        return computeHLLCFluxFromStates<dim>(rhoL, vL, uL, pL, cL, rhoR, vR, uR, pR, cR, axis);
+    }
+    static std::string name() { return "HLLC"; }
+};
+
+// local Lax-Friedrichs: the central flux plus dissipation at the fastest signal speed
+struct RusanovSolver {
+    template<int dim>
+    static inline HLLFlux<dim>
+    flux(double rhoL, const Lin::Vector<dim>& vL, double uL, double pL, double cL,
+         double rhoR, const Lin::Vector<dim>& vR, double uR, double pR, double cR, int axis) {
+        using Vector = Lin::Vector<dim>;
+        double vnL = vL[axis], vnR = vR[axis];
+        Vector momL = vL * rhoL, momR = vR * rhoR;
+        double EL = rhoL * (uL + 0.5 * vL.mag2());
+        double ER = rhoR * (uR + 0.5 * vR.mag2());
+
+        Vector momFluxL = momL * vnL; momFluxL[axis] += pL;
+        Vector momFluxR = momR * vnR; momFluxR[axis] += pR;
+
+        double s = std::max(std::abs(vnL) + cL, std::abs(vnR) + cR);
+        HLLFlux<dim> flux;
+        flux.mass     = 0.5 * (rhoL * vnL + rhoR * vnR - s * (rhoR - rhoL));
+        flux.momentum = 0.5 * (momFluxL + momFluxR - s * (momR - momL));
+        flux.energy   = 0.5 * (vnL * (EL + pL) + vnR * (ER + pR) - s * (ER - EL));
+        return flux;
+    }
+    static std::string name() { return "Rusanov"; }
+};
+
+// Toro's exact solver, sampled on the face. Each side is treated as a gamma-law gas
+// with gamma = 1 + P / (rho u), which keeps the reconstructed rho, u and P of a side
+// consistent with each other; it is exact for ideal gases and an approximation
+// otherwise. Sides that reach the face unchanged keep their own energy, and states that
+// come out of a shock or fan get theirs from P / ((gamma-1) rho). Falls back to Rusanov
+// for non-positive pressures or vacuum generation.
+struct ExactSolver {
+    struct Side {
+        double rho, vn, p, c, g;
+    };
+
+    // pressure function f_K(p) and its derivative for one side
+    static inline void
+    pressureFunction(const Side& K, double p, double& f, double& df) {
+        if (p > K.p) {
+            double A = 2.0 / ((K.g + 1.0) * K.rho);
+            double B = (K.g - 1.0) / (K.g + 1.0) * K.p;
+            double root = std::sqrt(A / (p + B));
+            f  = (p - K.p) * root;
+            df = root * (1.0 - 0.5 * (p - K.p) / (B + p));
+        } else {
+            double ratio = p / K.p;
+            f  = 2.0 * K.c / (K.g - 1.0) * (std::pow(ratio, 0.5 * (K.g - 1.0) / K.g) - 1.0);
+            df = std::pow(ratio, -0.5 * (K.g + 1.0) / K.g) / (K.rho * K.c);
+        }
+    }
+
+    // state on the face (x/t = 0) from side K, with sign = +1 on the left and -1 on
+    // the right. returns false if the face sees side K undisturbed
+    static inline bool
+    sample(const Side& K, double pStar, double vStar, double sign, double& rho, double& vn, double& p) {
+        const double g = K.g;
+        if (pStar > K.p) {
+            double ratio = pStar / K.p;
+            double S = K.vn - sign * K.c * std::sqrt(0.5 * (g + 1.0) / g * ratio + 0.5 * (g - 1.0) / g);
+            if (sign * S >= 0.0) return false;
+            double gm = (g - 1.0) / (g + 1.0);
+            rho = K.rho * (ratio + gm) / (gm * ratio + 1.0);
+            vn  = vStar;
+            p   = pStar;
+            return true;
+        }
+        double head = K.vn - sign * K.c;
+        if (sign * head >= 0.0) return false;
+        double cStar = K.c * std::pow(pStar / K.p, 0.5 * (g - 1.0) / g);
+        double tail = vStar - sign * cStar;
+        if (sign * tail <= 0.0) {
+            rho = K.rho * std::pow(pStar / K.p, 1.0 / g);
+            vn  = vStar;
+            p   = pStar;
+        } else {
+            double c = 2.0 / (g + 1.0) * (K.c + sign * 0.5 * (g - 1.0) * K.vn);
+            rho = K.rho * std::pow(c / K.c, 2.0 / (g - 1.0));
+            vn  = sign * c;
+            p   = K.p * std::pow(c / K.c, 2.0 * g / (g - 1.0));
+        }
+        return true;
+    }
+
+    template<int dim>
+    static inline HLLFlux<dim>
+    flux(double rhoL, const Lin::Vector<dim>& vL, double uL, double pL, double cL,
+         double rhoR, const Lin::Vector<dim>& vR, double uR, double pR, double cR, int axis) {
+        using Vector = Lin::Vector<dim>;
+        if (!(pL > 0.0 && pR > 0.0 && rhoL > 0.0 && rhoR > 0.0))
+            return RusanovSolver::flux<dim>(rhoL, vL, uL, pL, cL, rhoR, vR, uR, pR, cR, axis);
+
+        Side L, R;
+        L.rho = rhoL; L.vn = vL[axis]; L.p = pL; L.g = std::max(1.0 + pL / (rhoL * uL), 1.0 + 1e-6);
+        R.rho = rhoR; R.vn = vR[axis]; R.p = pR; R.g = std::max(1.0 + pR / (rhoR * uR), 1.0 + 1e-6);
+        L.c = std::sqrt(L.g * pL / rhoL);
+        R.c = std::sqrt(R.g * pR / rhoR);
+        double dv = R.vn - L.vn;
+        if (2.0 * L.c / (L.g - 1.0) + 2.0 * R.c / (R.g - 1.0) <= dv)
+            return RusanovSolver::flux<dim>(rhoL, vL, uL, pL, cL, rhoR, vR, uR, pR, cR, axis);
+
+        // Newton on f_L(p) + f_R(p) + dv = 0 from the PVRS guess
+        const double pFloor = 1e-12 * std::max(pL, pR);
+        double pStar = std::max(pFloor, 0.5 * (pL + pR) - 0.125 * dv * (rhoL + rhoR) * (cL + cR));
+        double fL, dfL, fR, dfR;
+        for (int it = 0; it < 20; ++it) {
+            pressureFunction(L, pStar, fL, dfL);
+            pressureFunction(R, pStar, fR, dfR);
+            double pNew = std::max(pStar - (fL + fR + dv) / (dfL + dfR), pFloor);
+            double change = 2.0 * std::abs(pNew - pStar) / (pNew + pStar);
+            pStar = pNew;
+            if (change < 1e-8) break;
+        }
+        pressureFunction(L, pStar, fL, dfL);
+        pressureFunction(R, pStar, fR, dfR);
+        double vStar = 0.5 * (L.vn + R.vn) + 0.5 * (fR - fL);
+
+        // the contact picks the side, and with it the tangential velocity
+        const bool left = vStar >= 0.0;
+        const Side& K = (left ? L : R);
+        double rho, vn, p, u;
+        Vector v = (left ? vL : vR);
+        if (sample(K, pStar, vStar, (left ? 1.0 : -1.0), rho, vn, p)) {
+            u = p / ((K.g - 1.0) * rho);
+            v[axis] = vn;
+        } else {
+            rho = K.rho;
+            p   = K.p;
+            u   = (left ? uL : uR);
+        }
+
+        HLLFlux<dim> flux;
+        vn = v[axis];
+        flux.mass     = rho * vn;
+        flux.momentum = v * (rho * vn); flux.momentum[axis] += p;
+        flux.energy   = vn * (rho * (u + 0.5 * v.mag2()) + p);
+        return flux;
+    }
+    static std::string name() { return "Exact"; }
+};
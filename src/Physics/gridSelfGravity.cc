@@ -0,0 +1,168 @@
+// Copyright (C) 2025  Cody Raskin
+
+#include "physics.hh"
+#include "../Mesh/grid.hh"
+#include "../Mesh/multigrid.hh"
+#include <iostream>
+#include <stdexcept>
+
+// Self-gravity for grid hydro: lap(phi) = 4 pi G rho is solved on the hydro grid with
+// geometric multigrid and the cells are accelerated by -grad(phi), the same way
+// ConstantGridAccel applies its uniform vector. The potential is kept in the nodeList
+// and used as the initial guess for the next solve, so a step usually needs only a
+// couple of cycles.
+//
+// boundary is "dirichlet" (phi = 0 on the grid faces), "periodic" (mean density
+// removed), or "isolated" (face values from the monopole of the mass on the grid).
+template <int dim>
+class GridSelfGravity : public Physics<dim> {
+protected:
+    Mesh::Grid<dim>* grid;
+    Mesh::Multigrid<dim> multigrid;
+    std::string boundary;
+    double tolerance = 1e-6;
+    int maxCycles = 20;
+    int lastCycles = 0;
+    double dxmin = 1e30;
+    double dtmin = 1e30;
+    static constexpr int maxCoarsest = 16;
+
+    std::vector<double> phi, rhs;
+    double totalMass = 0;
+    Lin::Vector<dim> centerOfMass;
+
+public:
+    using Vector = Lin::Vector<dim>;
+    using VectorField = Field<Vector>;
+    using ScalarField = Field<double>;
+
+    GridSelfGravity(NodeList* nodeList, PhysicalConstants& constants, Mesh::Grid<dim>* grid, std::string boundary) :
+        Physics<dim>(nodeList, constants),
+        grid(grid),
+        multigrid(grid, BoundaryTypeFor(boundary)),
+        boundary(boundary) {
+        // the coarsest level gets O(n^2) sweeps every cycle, which only pays off when it is small
+        if (multigrid.coarsestSize() > maxCoarsest)
+            throw std::invalid_argument("GridSelfGravity: every axis of the grid must halve down to " +
+                                        std::to_string(maxCoarsest) + " cells or fewer (a small number times a power of two); this grid stops at " +
+                                        std::to_string(multigrid.coarsestSize()));
+
+        this->template EnrollFields<double>({"density", "potential"});
+        this->template EnrollFields<Vector>({"acceleration", "velocity", "position"});
+        this->template EnrollStateFields<Vector>({"velocity"});
+
+        for (int d = 0; d < dim; ++d)
+            dxmin = std::min(dxmin, grid->spacing(d));
+
+        if (boundary == "isolated")
+            multigrid.setBoundaryValues([this](int cell, int axis, int side) {
+                Vector face = this->grid->getPosition(cell);
+                face[axis] += 0.5 * side * this->grid->spacing(axis);
+                return MonopolePotential((face - centerOfMass).magnitude());
+            });
+    }
+
+    GridSelfGravity(NodeList* nodeList, PhysicalConstants& constants, Mesh::Grid<dim>* grid) :
+        GridSelfGravity(nodeList, constants, grid, "isolated") {}
+
+    ~GridSelfGravity() {}
+
+    virtual void
+    EvaluateDerivatives(const State<dim>* initialState, State<dim>& deriv, const double time, const double dt) override {
+        NodeList* nodeList = this->nodeList;
+        int numZones = nodeList->size();
+
+        ScalarField* density      = nodeList->getField<double>("density");
+        ScalarField* potential    = nodeList->getField<double>("potential");
+        VectorField* acceleration = nodeList->getField<Vector>("acceleration");
+        VectorField* dvdt         = deriv.template getField<Vector>("velocity");
+
+        SolvePotential(density, potential);
+
+        double amax = 0;
+        #pragma omp parallel for reduction(max:amax)
+        for (int i = 0; i < numZones; ++i) {
+            Vector a;
+            for (int d = 0; d < dim; ++d)
+                a[d] = -multigrid.gradient(phi, i, d);
+            acceleration->setValue(i, a);
+            dvdt->setValue(i, a);
+            amax = std::max(amax, a.magnitude());
+        }
+
+        // a cell shouldn't fall more than a fraction of its width in one step
+        dtmin = (amax > 0 ? 0.5 * std::sqrt(dxmin / amax) : 1e30);
+        this->lastDt = dt;
+    }
+
+    virtual double
+    EstimateTimestep() const override {
+        return dtmin;
+    }
+
+    inline std::string getBoundary() const { return boundary; }
+    inline double getTolerance() const { return tolerance; }
+    inline void setTolerance(const double value) { tolerance = value; }
+    inline int getMaxCycles() const { return maxCycles; }
+    inline void setMaxCycles(const int value) { maxCycles = value; }
+    inline int getLastCycles() const { return lastCycles; }
+    inline bool isFCycle() const { return multigrid.isFCycle(); }
+    inline void setFCycle(const bool value) { multigrid.setFCycle(value); }
+
+    virtual std::string name() const override { return "gridSelfGravity"; }
+    virtual std::string description() const override {
+        return "Multigrid self-gravity on the grid"; }
+
+protected:
+    static typename Mesh::Multigrid<dim>::BoundaryType
+    BoundaryTypeFor(const std::string& boundary) {
+        if (boundary == "periodic")
+            return Mesh::Multigrid<dim>::BoundaryType::Periodic;
+        if (boundary == "dirichlet" || boundary == "isolated")
+            return Mesh::Multigrid<dim>::BoundaryType::Dirichlet;
+        throw std::invalid_argument("GridSelfGravity: boundary must be dirichlet, periodic or isolated");
+    }
+
+    // the free-space potential of the whole mass at distance r, for the isolated faces
+    double
+    MonopolePotential(const double r) const {
+        const double G = this->constants.G();
+        if constexpr (dim == 3)
+            return -G * totalMass / r;
+        else if constexpr (dim == 2)
+            return 2.0 * G * totalMass * std::log(r);
+        else
+            return 2.0 * M_PI * G * totalMass * r;
+    }
+
+    void
+    SolvePotential(ScalarField* density, ScalarField* potential) {
+        const int numZones = grid->size();
+        const double fourPiG = 4.0 * M_PI * this->constants.G();
+        rhs.resize(numZones);
+        phi.resize(numZones);
+
+        double mass = 0;
+        Vector moment = Vector::zero();
+        #pragma omp parallel for
+        for (int i = 0; i < numZones; ++i) {
+            rhs[i] = fourPiG * density->getValue(i);
+            phi[i] = potential->getValue(i);
+        }
+        if (boundary == "isolated") {
+            for (int i = 0; i < numZones; ++i) {
+                double mi = density->getValue(i) * grid->cellVolume(i);
+                mass   += mi;
+                moment += mi * grid->getPosition(i);
+            }
+            totalMass = mass;
+            centerOfMass = (mass > 0 ? moment / mass : Vector::zero());
+        }
+
+        lastCycles = multigrid.solve(phi, rhs, tolerance, maxCycles);
+
+        #pragma omp parallel for
+        for (int i = 0; i < numZones; ++i)
+            potential->setValue(i, phi[i]);
+    }
+};
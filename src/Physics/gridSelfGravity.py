@@ -0,0 +1,38 @@
+from PYB11Generator import *
+from physics import *
+
+@PYB11template("dim")
+class GridSelfGravity(Physics):
+    def pyinit(self,
+               nodeList="NodeList*",
+               constants="PhysicalConstants&",
+               grid="Mesh::Grid<%(dim)s>*"):
+        return
+    def pyinit1(self,
+               nodeList="NodeList*",
+               constants="PhysicalConstants&",
+               grid="Mesh::Grid<%(dim)s>*",
+               boundary="std::string"):
+        "boundary is isolated, periodic or dirichlet"
+        return
+    boundary = PYB11property("std::string", getter="getBoundary", doc="Boundary condition on the potential.")
+    tolerance = PYB11property("double", getter="getTolerance", setter="setTolerance", doc="Residual reduction the solve stops at.")
+    maxCycles = PYB11property("int", getter="getMaxCycles", setter="setMaxCycles", doc="Most multigrid cycles per solve.")
+    lastCycles = PYB11property("int", getter="getLastCycles", doc="Cycles taken by the last solve.")
+    fcycle = PYB11property("bool", getter="isFCycle", setter="setFCycle", doc="Use F-cycles instead of V-cycles.")
+
+GridSelfGravity1d = PYB11TemplateClass(GridSelfGravity,
+                              template_parameters = ("1"),
+                              cppname = "GridSelfGravity<1>",
+                              pyname = "GridSelfGravity1d",
+                              docext = " (1D).")
+GridSelfGravity2d = PYB11TemplateClass(GridSelfGravity,
+                              template_parameters = ("2"),
+                              cppname = "GridSelfGravity<2>",
+                              pyname = "GridSelfGravity2d",
+                              docext = " (2D).")
+GridSelfGravity3d = PYB11TemplateClass(GridSelfGravity,
+                              template_parameters = ("3"),
+                              cppname = "GridSelfGravity<3>",
+                              pyname = "GridSelfGravity3d",
+                              docext = " (3D).")
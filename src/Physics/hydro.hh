@@ -10,15 +10,31 @@ template <int dim>
 class Hydro : public Physics<dim> {
 protected:
     EquationOfState* eos;
+    std::vector<EquationOfState*> materials;   // materials[0] is eos
 public:
 
-    Hydro(NodeList* nodeList, PhysicalConstants& constants, EquationOfState* eos) : 
-        Physics<dim>(nodeList,constants), eos(eos) {
-        this->template EnrollFields<double>({"pressure", "density", "specificInternalEnergy", "soundSpeed"});
+    // soundSpeed only sets signal speeds, so a scheme may store it in single precision
+    Hydro(NodeList* nodeList, PhysicalConstants& constants, EquationOfState* eos,
+          Precision soundSpeedPrecision = Precision::Double) : 
+        Physics<dim>(nodeList,constants), eos(eos), materials({eos}) {
+        this->template EnrollFields<double>({"pressure", "density", "specificInternalEnergy"});
+        this->template EnrollFields<double>({"soundSpeed"}, soundSpeedPrecision);
+        this->template EnrollFields<int>({"materialId"});
     }
 
     virtual ~Hydro() {}
 
+    // Registers another material and returns its id, the value to put in the
+    // "materialId" field of its cells. Material 0 is the eos given at construction.
+    virtual int
+    AddMaterial(EquationOfState* materialEOS) {
+        materials.push_back(materialEOS);
+        return materials.size() - 1;
+    }
+
+    inline int numMaterials() const { return materials.size(); }
+    inline EquationOfState* getMaterial(const int id) const { return materials.at(id); }
+
     virtual std::string name() const override { return "hydro"; }
     virtual std::string description() const override {
         return "Some kind of hydro"; }
@@ -8,6 +8,11 @@ class Hydro(Physics):
                constants="PhysicalConstants&",
                eos="EquationOfState*"):
         return
+    def AddMaterial(self,
+                    materialEOS="EquationOfState*"):
+        "Register another material's EOS; returns its materialId"
+        return "int"
+    numMaterials = PYB11property("int", getter="numMaterials", doc="Number of registered materials.")
 
 Hydro1d = PYB11TemplateClass(Hydro,
                               template_parameters = ("1"),
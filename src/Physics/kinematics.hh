@@ -22,6 +22,37 @@ public:
 
     ~Kinematics() {}
 
+    // Hierarchical block timesteps (BlockTimestepIntegrator) call these two instead of
+    // EvaluateDerivatives: accelerations are only needed for the active nodes, with every
+    // node sitting at its predicted position in the nodeList. The fallback evaluates
+    // everything, so packages that can do a subset cheaply should override it.
+    virtual void
+    EvaluateAccelerations(const double time, const std::vector<int>& active) {
+        NodeList* nodeList = this->nodeList;
+        State<dim> current(nodeList->size());
+        current.template addField<Vector>(nodeList->getField<Vector>("position"));
+        current.template addField<Vector>(nodeList->getField<Vector>("velocity"));
+        State<dim> deriv(nodeList->size());
+        deriv.ghost(&current);
+
+        this->EvaluateDerivatives(&current, deriv, time, 0);
+
+        VectorField* dvdt           = deriv.template getField<Vector>("velocity");
+        VectorField* acceleration   = nodeList->getField<Vector>("acceleration");
+        for (int i : active)
+            acceleration->setValue(i, dvdt->getValue(i));
+    }
+
+    // the timestep node i would ask for on its own; EstimateTimestep is the minimum over nodes
+    virtual double
+    NodeTimestep(const Vector& v, const Vector& a) const { return 1e30; }
+
+    // Hermite integrators need the jerk (da/dt) alongside the acceleration at the
+    // positions and velocities in state. Packages that can do both in one pass
+    // override this and return true.
+    virtual bool
+    EvaluateJerks(const State<dim>* state, std::vector<Vector>& acceleration, std::vector<Vector>& jerk) { return false; }
+
     virtual std::string name() const override { return "kinematics"; }
     virtual std::string description() const override {
         return "Kinematics physics package for particles"; }
@@ -1,6 +1,7 @@
 // Copyright (C) 2025  Cody Raskin
 
 #include "kinematics.hh"
+#include "../Trees/cellList.hh"
 #include <iostream>
 
 template <int dim>
@@ -37,20 +38,23 @@ public:
 
             //VectorField* dxdt           = deriv.template getField<Vector>("position");
             double local_dtmin = 1e30;
+            double maxRadius = 0;
 
-            #pragma omp parallel for reduction(min:local_dtmin)
-            for (int i = 0; i < numNodes - 1; ++i) {
-                dtmin = 1e30;
-                for (int j = i + 1; j < numNodes; ++j) {
-                    Vector ri = position->getValue(i);
-                    Vector rj = position->getValue(j);
+            #pragma omp parallel for reduction(max:maxRadius)
+            for (int i = 0; i < numNodes; ++i)
+                maxRadius = std::max(maxRadius, radius->getValue(i));
+
+            if (maxRadius > 0) {
+                // no two particles can touch from further than two of the largest radii apart,
+                // so that sets the cell width and the search radius
+                CellList<dim> cells(position, 2*maxRadius);
+                cells.forEachPair(2*maxRadius, [&](int i, int j, const Vector& rij) {
                     double si = radius->getValue(i);
                     double sj = radius->getValue(j);
                     Vector vi = velocity->getValue(i);
                     Vector vj = velocity->getValue(j);
 
                     Vector vij = vi-vj;
-                    Vector rij = ri-rj;
 
                     if (rij.magnitude() < (si+sj) && vij*rij<0) { //collision
                         double mi = mass->getValue(i);
@@ -61,12 +65,12 @@ public:
 
                         velocity->setValue(i,vip);
                         velocity->setValue(j,vjp);
-                        // dxdt->setValue(i,vip);
-                        // dxdt->setValue(j,vjp);
-
-                        continue;  // skip this i (1 collision only please!)
                     }
-                }
+                });
+            }
+
+            #pragma omp parallel for reduction(min:local_dtmin)
+            for (int i = 0; i < numNodes - 1; ++i) {
                 Vector vi = velocity->getValue(i);
                 double si = radius->getValue(i);
                 local_dtmin = std::min(local_dtmin,0.25*si/vi.magnitude());
@@ -37,16 +37,7 @@ public:
 
         #pragma omp parallel for reduction(min:local_dtmin)
         for (int i=0; i<numNodes ; ++i) {
-            Vector a = Vector::zero();
-            Vector rij = Vector();
-            for (int j=0; j<numNodes; ++j)
-            {
-                if (j!=i) {
-                    rij = position->getValue(j) - position->getValue(i);
-                    double mj = mass->getValue(j);
-                    a += constants.G()*mj/(rij.mag2()+plummerLength)*rij.normal();
-                }
-            }
+            Vector a = AccelerationOn(i, position, mass);
             Vector v = velocity->getValue(i);
             acceleration->setValue(i,a);
             double amag = a.mag2();
@@ -67,7 +58,79 @@ public:
         return timestep;
     }
 
+    virtual void
+    EvaluateAccelerations(const double time, const std::vector<int>& active) override {
+        NodeList* nodeList = this->nodeList;
+        ScalarField* mass           = nodeList->getField<double>("mass");
+        VectorField* position       = nodeList->getField<Vector>("position");
+        VectorField* acceleration   = nodeList->getField<Vector>("acceleration");
+
+        #pragma omp parallel for
+        for (int k=0; k<(int)active.size(); ++k)
+            acceleration->setValue(active[k], AccelerationOn(active[k], position, mass));
+    }
+
+    virtual double
+    NodeTimestep(const Vector& v, const Vector& a) const override {
+        return 1e-2*sqrt(v.mag2()/a.mag2());
+    }
+
+    // acceleration and its time derivative in one sweep. with f = G mj/((r^2+eps) r),
+    // a = f rij and da/dt = f (vij - (3r^2+eps)(rij.vij)/(r^2 (r^2+eps)) rij)
+    virtual bool
+    EvaluateJerks(const State<dim>* state, std::vector<Vector>& acc, std::vector<Vector>& jerk) override {
+        NodeList* nodeList = this->nodeList;
+        int numNodes = nodeList->size();
+
+        ScalarField* mass           = nodeList->getField<double>("mass");
+        VectorField* position       = state->template getField<Vector>("position");
+        VectorField* velocity       = state->template getField<Vector>("velocity");
+        VectorField* acceleration   = nodeList->getField<Vector>("acceleration");
+
+        const double G = this->constants.G();
+        acc.resize(numNodes);
+        jerk.resize(numNodes);
+
+        #pragma omp parallel for
+        for (int i=0; i<numNodes; ++i) {
+            Vector a = Vector::zero();
+            Vector j = Vector::zero();
+            for (int k=0; k<numNodes; ++k) {
+                if (k!=i) {
+                    Vector rij = position->getValue(k) - position->getValue(i);
+                    Vector vij = velocity->getValue(k) - velocity->getValue(i);
+                    double r2 = rij.mag2();
+                    double f = G*mass->getValue(k)/((r2+plummerLength)*sqrt(r2));
+                    double s = rij*vij;
+                    a += f*rij;
+                    j += f*(vij - ((3*r2+plummerLength)*s/(r2*(r2+plummerLength)))*rij);
+                }
+            }
+            acc[i] = a;
+            jerk[i] = j;
+            acceleration->setValue(i,a);
+        }
+        return true;
+    }
+
     virtual std::string name() const override { return "nBodyGravity"; }
     virtual std::string description() const override {
         return "N-body gravity physics package for particles"; }
+
+protected:
+    Vector
+    AccelerationOn(const int i, VectorField* position, ScalarField* mass) const {
+        const int numNodes = position->size();
+        Vector a = Vector::zero();
+        Vector rij = Vector();
+        for (int j=0; j<numNodes; ++j)
+        {
+            if (j!=i) {
+                rij = position->getValue(j) - position->getValue(i);
+                double mj = mass->getValue(j);
+                a += this->constants.G()*mj/(rij.mag2()+plummerLength)*rij.normal();
+            }
+        }
+        return a;
+    }
 };
@@ -0,0 +1,297 @@
+// Copyright (C) 2025  Cody Raskin
+
+#include "kinematics.hh"
+#include "../Mesh/grid.hh"
+#include "../Math/fft.hh"
+#include <iostream>
+#include <stdexcept>
+
+// Particle-mesh gravity. Node masses are assigned to a Mesh::Grid (CIC or TSC),
+// Poisson's equation is solved with a real-to-complex FFT, the grid accelerations
+// come from centered differences of the potential, and they're interpolated back
+// to the nodes with the same assignment kernel so there's no self-force.
+//
+// Periodic boxes use the discrete Laplacian's Green's function with the mean density
+// removed. Isolated boxes are zero-padded to twice the size (Hockney & Eastwood), in which
+// case assignment cells that fall off the grid are dropped.
+// Poisson's equation is solved in dim dimensions, so in 1D and 2D the force falls off
+// like the 1D/2D Green's function rather than NBodyGravity's 1/r^2.
+// The grid has to be a power of two along each axis.
+template <int dim>
+class ParticleMeshGravity : public Kinematics<dim> {
+protected:
+    Mesh::Grid<dim>* grid;
+    bool periodic;
+    int order;                      // cells per axis in the assignment stencil: 2 = CIC, 3 = TSC
+    double dtmin;
+
+    std::array<int, 3> n, m;        // grid and (padded) transform sizes
+    std::array<double, 3> h, lo;    // spacing and lower corner of the grid
+    std::vector<double> greens;     // Green's function in k space, normalization folded in
+
+    std::vector<double> rho, phi;
+    std::vector<Lin::Complex> rhok;
+    std::array<std::vector<double>, dim> gridAccel;
+
+    struct Stencil {
+        std::array<std::array<int, 3>, 3> cell;
+        std::array<std::array<double, 3>, 3> w;
+        std::array<int, 3> count;
+    };
+
+public:
+    using Vector = Lin::Vector<dim>;
+    using VectorField = Field<Vector>;
+    using ScalarField = Field<double>;
+
+    ParticleMeshGravity(NodeList* nodeList, PhysicalConstants& constants, Mesh::Grid<dim>* grid,
+                        bool periodic, std::string assignment) :
+        Kinematics<dim>(nodeList,constants),
+        grid(grid),
+        periodic(periodic) {
+        if (assignment == "CIC")
+            order = 2;
+        else if (assignment == "TSC")
+            order = 3;
+        else
+            throw std::invalid_argument("ParticleMeshGravity: assignment must be CIC or TSC");
+
+        n = {grid->getnx(), grid->getny(), grid->getnz()};
+        h = {grid->getdx(), grid->getdy(), grid->getdz()};
+        for (int d = 0; d < 3; ++d) {
+            if (d < dim && (!Lin::isPowerOfTwo(n[d]) || (d == 0 && n[d] < 2)))
+                throw std::invalid_argument("ParticleMeshGravity: grid size must be a power of two along each axis");
+            m[d]  = (d < dim && !periodic ? 2 * n[d] : n[d]);
+        }
+
+        if (grid->template getField<double>("potential") == nullptr)
+            grid->template insertField<double>("potential");
+
+        ComputeGreens();
+    }
+
+    ParticleMeshGravity(NodeList* nodeList, PhysicalConstants& constants, Mesh::Grid<dim>* grid, bool periodic) :
+        ParticleMeshGravity(nodeList, constants, grid, periodic, "CIC") {}
+
+    ~ParticleMeshGravity() {}
+
+    virtual void
+    EvaluateDerivatives(const State<dim>* initialState, State<dim>& deriv, const double time, const double dt) override {
+        NodeList* nodeList = this->nodeList;
+        int numNodes = nodeList->size();
+
+        ScalarField* mass           = nodeList->getField<double>("mass");
+        VectorField* position       = initialState->template getField<Vector>("position");
+        VectorField* acceleration   = nodeList->getField<Vector>("acceleration");
+        VectorField* velocity       = initialState->template getField<Vector>("velocity");
+
+        VectorField* dxdt           = deriv.template getField<Vector>("position");
+        VectorField* dvdt           = deriv.template getField<Vector>("velocity");
+
+        SolveGrid(position, mass);
+
+        double local_dtmin = 1e30;
+
+        #pragma omp parallel for reduction(min:local_dtmin)
+        for (int i=0; i<numNodes ; ++i) {
+            Vector a = Interpolate(position->getValue(i));
+            Vector v = velocity->getValue(i);
+            acceleration->setValue(i,a);
+            double amag = a.mag2();
+            double vmag = v.mag2();
+            local_dtmin = std::min(local_dtmin,vmag/amag);
+            dxdt->setValue(i,v+dt*a);
+            dvdt->setValue(i,a);
+        }
+        dtmin  = local_dtmin;
+        this->lastDt = dt;
+    }
+
+    virtual double
+    EstimateTimestep() const override {
+        double timestepCoefficient = 1e-2; // Adjust as needed
+        double timestep = timestepCoefficient * sqrt(dtmin);
+
+        return timestep;
+    }
+
+    virtual double
+    NodeTimestep(const Vector& v, const Vector& a) const override {
+        return 1e-2*sqrt(v.mag2()/a.mag2());
+    }
+
+    inline bool isPeriodic() const { return periodic; }
+    inline std::string getAssignment() const { return (order == 2 ? "CIC" : "TSC"); }
+
+    virtual std::string name() const override { return "particleMeshGravity"; }
+    virtual std::string description() const override {
+        return "Particle-mesh FFT gravity for particles"; }
+
+protected:
+    inline int
+    padIndex(int i, int j, int k) const { return (k * m[1] + j) * m[0] + i; }
+
+    void
+    ComputeGreens() {
+        const double G = this->constants.G();
+        const int hx = m[0] / 2 + 1;
+        const int numModes = hx * m[1] * m[2];
+        const double total = (double)m[0] * m[1] * m[2];
+        greens.assign(numModes, 0.0);
+
+        if (periodic) {
+            // phi_k = -4 pi G rho_k / K^2, with K^2 the eigenvalue of the 2nd order Laplacian
+            double cellVolume = 1.0;
+            for (int d = 0; d < dim; ++d) cellVolume *= h[d];
+            #pragma omp parallel for
+            for (int q = 0; q < numModes; ++q) {
+                std::array<int, 3> k = {q % hx, (q / hx) % m[1], q / (hx * m[1])};
+                double K2 = 0.0;
+                for (int d = 0; d < dim; ++d) {
+                    double s = 2.0 * std::sin(M_PI * k[d] / m[d]) / h[d];
+                    K2 += s * s;
+                }
+                if (K2 > 0.0)
+                    greens[q] = -4.0 * M_PI * G / (K2 * cellVolume * total);
+            }
+            return;
+        }
+
+        // isolated: the free-space potential of a unit point mass, sampled on the padded grid
+        std::vector<double> kernel(m[0] * m[1] * m[2]);
+        double rmin = h[0];
+        for (int d = 1; d < dim; ++d) rmin = std::min(rmin, h[d]);
+        #pragma omp parallel for
+        for (int c = 0; c < (int)kernel.size(); ++c) {
+            std::array<int, 3> i = {c % m[0], (c / m[0]) % m[1], c / (m[0] * m[1])};
+            double r2 = 0.0;
+            for (int d = 0; d < dim; ++d) {
+                int o = (i[d] <= m[d] / 2 ? i[d] : i[d] - m[d]);
+                r2 += (o * h[d]) * (o * h[d]);
+            }
+            double r = (r2 > 0.0 ? std::sqrt(r2) : 0.5 * rmin);
+            if constexpr (dim == 3)
+                kernel[c] = -G / r;
+            else if constexpr (dim == 2)
+                kernel[c] = 2.0 * G * std::log(r);
+            else
+                kernel[c] = 2.0 * M_PI * G * r;
+        }
+        std::vector<Lin::Complex> kernelk;
+        Lin::rfftn(kernel, kernelk, m);
+        #pragma omp parallel for
+        for (int q = 0; q < numModes; ++q)
+            greens[q] = kernelk[q].real() / total;
+    }
+
+    // cells and weights along each axis for a node at x
+    void
+    AssignmentStencil(const Vector& x, Stencil& s) const {
+        for (int d = 0; d < 3; ++d) {
+            if (d >= dim) {
+                s.cell[d][0] = 0;
+                s.w[d][0] = 1.0;
+                s.count[d] = 1;
+                continue;
+            }
+            double u = (x[d] - lo[d]) / h[d] - 0.5;   // in units of cells, 0 at the first center
+            int first;
+            if (order == 2) {
+                first = (int)std::floor(u);
+                double f = u - first;
+                s.w[d][0] = 1.0 - f;
+                s.w[d][1] = f;
+            } else {
+                int c = (int)std::floor(u + 0.5);
+                double f = u - c;
+                first = c - 1;
+                s.w[d][0] = 0.5 * (0.5 - f) * (0.5 - f);
+                s.w[d][1] = 0.75 - f * f;
+                s.w[d][2] = 0.5 * (0.5 + f) * (0.5 + f);
+            }
+            s.count[d] = order;
+            for (int k = 0; k < order; ++k) {
+                int c = first + k;
+                if (periodic)
+                    c = ((c % n[d]) + n[d]) % n[d];
+                else if (c < 0 || c >= n[d])
+                    s.w[d][k] = 0.0;
+                s.cell[d][k] = std::min(std::max(c, 0), n[d] - 1);
+            }
+        }
+    }
+
+    void
+    SolveGrid(VectorField* position, ScalarField* mass) {
+        const int numNodes = position->size();
+        const int numCells = n[0] * n[1] * n[2];
+        for (int d = 0; d < 3; ++d)
+            lo[d] = (d < dim ? grid->gridPositions[0][d] - 0.5 * h[d] : 0.0);   // in case setOrigin moved it
+
+        rho.assign(m[0] * m[1] * m[2], 0.0);
+        #pragma omp parallel for
+        for (int p = 0; p < numNodes; ++p) {
+            Stencil s;
+            AssignmentStencil(position->getValue(p), s);
+            const double mp = mass->getValue(p);
+            for (int c = 0; c < s.count[2]; ++c)
+                for (int b = 0; b < s.count[1]; ++b)
+                    for (int a = 0; a < s.count[0]; ++a) {
+                        double w = mp * s.w[0][a] * s.w[1][b] * s.w[2][c];
+                        int idx = padIndex(s.cell[0][a], s.cell[1][b], s.cell[2][c]);
+                        #pragma omp atomic
+                        rho[idx] += w;
+                    }
+        }
+
+        Lin::rfftn(rho, rhok, m);
+        #pragma omp parallel for
+        for (int q = 0; q < (int)rhok.size(); ++q)
+            rhok[q] *= greens[q];
+        Lin::irfftn(rhok, phi, m);
+
+        ScalarField* potential = grid->template getField<double>("potential");
+        #pragma omp parallel for
+        for (int c = 0; c < numCells; ++c) {
+            int i = c % n[0], j = (c / n[0]) % n[1], k = c / (n[0] * n[1]);
+            potential->setValue(c, phi[padIndex(i, j, k)]);
+        }
+
+        // g = -grad phi with centered differences, one-sided at the edge of an isolated grid
+        for (int d = 0; d < dim; ++d) {
+            gridAccel[d].resize(numCells);
+            #pragma omp parallel for
+            for (int c = 0; c < numCells; ++c) {
+                std::array<int, 3> i = {c % n[0], (c / n[0]) % n[1], c / (n[0] * n[1])};
+                std::array<int, 3> ip = i, im = i;
+                ip[d]++;
+                im[d]--;
+                double span = 2.0 * h[d];
+                if (periodic) {
+                    ip[d] = (ip[d] + n[d]) % n[d];
+                    im[d] = (im[d] + n[d]) % n[d];
+                } else {
+                    if (ip[d] == n[d]) { ip[d]--; span = h[d]; }
+                    if (im[d] < 0)     { im[d]++; span = h[d]; }
+                }
+                gridAccel[d][c] = -(phi[padIndex(ip[0], ip[1], ip[2])] - phi[padIndex(im[0], im[1], im[2])]) / span;
+            }
+        }
+    }
+
+    Vector
+    Interpolate(const Vector& x) const {
+        Stencil s;
+        AssignmentStencil(x, s);
+        Vector a = Vector::zero();
+        for (int c = 0; c < s.count[2]; ++c)
+            for (int b = 0; b < s.count[1]; ++b)
+                for (int q = 0; q < s.count[0]; ++q) {
+                    double w = s.w[0][q] * s.w[1][b] * s.w[2][c];
+                    int idx = grid->index(s.cell[0][q], s.cell[1][b], s.cell[2][c]);
+                    for (int d = 0; d < dim; ++d)
+                        a[d] += w * gridAccel[d][idx];
+                }
+        return a;
+    }
+};
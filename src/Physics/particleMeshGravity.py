@@ -0,0 +1,37 @@
+from PYB11Generator import *
+from physics import *
+
+@PYB11template("dim")
+class ParticleMeshGravity(Physics):
+    def pyinit(self,
+               nodeList="NodeList*",
+               constants="PhysicalConstants&",
+               grid="Mesh::Grid<%(dim)s>*",
+               periodic="bool"):
+        return
+    def pyinit1(self,
+               nodeList="NodeList*",
+               constants="PhysicalConstants&",
+               grid="Mesh::Grid<%(dim)s>*",
+               periodic="bool",
+               assignment="std::string"):
+        "assignment is CIC or TSC"
+        return
+    periodic = PYB11property("bool", getter="isPeriodic", doc="Periodic box, otherwise isolated.")
+    assignment = PYB11property("std::string", getter="getAssignment", doc="Mass assignment scheme.")
+
+ParticleMeshGravity1d = PYB11TemplateClass(ParticleMeshGravity,
+                              template_parameters = ("1"),
+                              cppname = "ParticleMeshGravity<1>",
+                              pyname = "ParticleMeshGravity1d",
+                              docext = " (1D).")
+ParticleMeshGravity2d = PYB11TemplateClass(ParticleMeshGravity,
+                              template_parameters = ("2"),
+                              cppname = "ParticleMeshGravity<2>",
+                              pyname = "ParticleMeshGravity2d",
+                              docext = " (2D).")
+ParticleMeshGravity3d = PYB11TemplateClass(ParticleMeshGravity,
+                              template_parameters = ("3"),
+                              cppname = "ParticleMeshGravity<3>",
+                              pyname = "ParticleMeshGravity3d",
+                              docext = " (3D).")
@@ -3,7 +3,7 @@
 #include "physics.hh"
 #include <iostream>
 #include <cmath>
-#include "../Trees/kdTree.hh"
+#include "../Trees/neighborList.hh"
 
 // Kuramoto, Yoshiki (1975). H. Araki (ed.). 
 // Lecture Notes in Physics, 
@@ -15,6 +15,7 @@ class PhaseCoupling : public Physics<dim> {
 protected:
     double couplingConstant, dtmin;
     double searchRadius=0;
+    std::shared_ptr<NeighborList<dim>> neighbors;
     inline double mod2pi(double x) {
         double twopi = 2.0 * M_PI;
         double result = std::fmod(x, twopi);
@@ -41,6 +42,8 @@ public:
         couplingConstant(couplingConstant),
         searchRadius(searchRadius) {
         Enroll();
+        if (searchRadius > 0)
+            neighbors = NeighborList<dim>::get(nodeList, searchRadius, 0.2*searchRadius);
     }
 
     void
@@ -63,24 +66,41 @@ public:
         double local_dtmin = 1e30;
 
         int numNodes = nodeList->size();
-        KDTree tree(x);  // this isn't zero cost, but it also isn't extremely expensive
-        #pragma omp parallel for reduction(min:local_dtmin)
-        for(int i=0; i<numNodes; ++i) {
-            Vector xi = x->getValue(i);
-            dph->setValue(i, omega->getValue(i));
-            std::vector<int> neighbors  = tree.findNearestNeighbors(xi, searchRadius);
-            int nbrs = (searchRadius == 0? numNodes : neighbors.size());
-            double norm = (searchRadius == 0? (numNodes-1) : std::max(1, (int)neighbors.size()));
-            for(int k=0; k<nbrs; ++k) {
-                int j = (searchRadius == 0? k : neighbors[k]);
-                Vector xj = x->getValue(j);
-                double xij = std::max((xi - xj).magnitude(), 0.005);
-                double K = couplingConstant / xij;
+        if (searchRadius == 0) {
+            #pragma omp parallel for reduction(min:local_dtmin)
+            for(int i=0; i<numNodes; ++i) {
+                Vector xi = x->getValue(i);
                 double pi = phase->getValue(i);
-                double pj = phase->getValue(j);
-
-                dph->setValue(i, dph->getValue(i) + K*sin(pj-pi)/norm);
-                local_dtmin = std::min(local_dtmin,1/K);
+                double norm = numNodes-1;
+                double dphi = omega->getValue(i);
+                for(int j=0; j<numNodes; ++j) {
+                    Vector xj = x->getValue(j);
+                    double xij = std::max((xi - xj).magnitude(), 0.005);
+                    double K = couplingConstant / xij;
+                    dphi += K*sin(phase->getValue(j)-pi)/norm;
+                    local_dtmin = std::min(local_dtmin,1/K);
+                }
+                dph->setValue(i, dphi);
+            }
+        } else {
+            neighbors->update(x);  // only rebuilds once something has moved more than half the skin
+            const double r2 = searchRadius*searchRadius;
+            #pragma omp parallel for reduction(min:local_dtmin)
+            for(int i=0; i<numNodes; ++i) {
+                Vector xi = x->getValue(i);
+                double pi = phase->getValue(i);
+                double dphi = 0;
+                int nbrs = 0;
+                neighbors->forEachNeighbor(i, [&](int j) {
+                    Vector rij = xi - x->getValue(j);
+                    if (rij.mag2() > r2) return;
+                    double xij = std::max(rij.magnitude(), 0.005);
+                    double K = couplingConstant / xij;
+                    dphi += K*sin(phase->getValue(j)-pi);
+                    local_dtmin = std::min(local_dtmin,1/K);
+                    nbrs++;
+                });
+                dph->setValue(i, omega->getValue(i) + dphi/std::max(1, nbrs));
             }
         }
 
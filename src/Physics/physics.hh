@@ -7,10 +7,23 @@
 #include "../Type/physicalConstants.hh"
 #include "../State/state.hh"
 #include "../Boundaries/boundary.hh"
+#include <stdexcept>
+#include <type_traits>
 
 template <int dim>
 class Boundary; // forward declaration
 
+// Storage of an enrolled scalar field. A Single field is a Field<float> that kernels
+// widen to double as they load it; fields in a State are always Double.
+enum class Precision { Double, Single };
+
+inline Precision
+ParsePrecision(const std::string& precision) {
+    if (precision == "double") return Precision::Double;
+    if (precision == "single") return Precision::Single;
+    throw std::invalid_argument("precision must be double or single");
+}
+
 template <int dim>
 class Physics {
 protected:
@@ -18,6 +31,7 @@ protected:
     PhysicalConstants& constants;
     State<dim> state;
     double lastDt;
+    double stepDt = 0;  // the integrator's full step, handed over before PreStepInitialize
     std::vector<Boundary<dim>*> boundaries;
 public:
     using Vector = Lin::Vector<dim>;
@@ -37,12 +51,35 @@ public:
 
     template <typename T>
     void
-    EnrollFields(std::initializer_list<const std::string> fields) {
+    EnrollFields(std::initializer_list<const std::string> fields, Precision precision = Precision::Double) {
         for (const std::string& name : fields) {
+            if constexpr (std::is_same<T, double>::value) {
+                // a field keeps the storage of whichever package enrolled it first; a package
+                // that asks for single precision reads either, one that asks for double cannot
+                if (nodeList->getField<float>(name) != nullptr) {
+                    if (precision == Precision::Single) continue;
+                    throw std::invalid_argument(name + " is already stored in single precision, "
+                                                "which this package cannot read");
+                }
+                if (precision == Precision::Single && nodeList->getField<double>(name) == nullptr) {
+                    nodeList->insertField<float>(name);
+                    continue;
+                }
+            }
             nodeList->insertField<T>(name);
         }
     }
 
+    // calls f with the named scalar field as it is stored, a Field<double>* or a Field<float>*
+    template <typename Function>
+    void
+    WithScalarField(const std::string& name, Function&& f) const {
+        if (Field<float>* single = nodeList->getField<float>(name))
+            f(single);
+        else
+            f(nodeList->getField<double>(name));
+    }
+
     template <typename T>
     void
     EnrollStateFields(std::initializer_list<const std::string> fields) {
@@ -67,6 +104,9 @@ public:
     virtual void
     EvaluateDerivatives(const State<dim>* initialState, State<dim>& deriv, const double time, const double dt)  {  }
 
+    virtual void
+    SetStepDt(const double dt) { stepDt = dt; }
+
     virtual void
     PreStepInitialize() {
         state.updateLastDt(lastDt);
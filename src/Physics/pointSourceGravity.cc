@@ -11,6 +11,7 @@ protected:
     double pointSourceMass;
     double dtmin;
     double lastUpdateTime = -1.0; // Tracks last update time
+    double blockTime = -1.0;      // same, for block timestep substeps
 public:
     using Vector = Lin::Vector<dim>;
     using VectorField = Field<Vector>;
@@ -77,6 +78,30 @@ public:
         return timestep;
     }
 
+    virtual void
+    EvaluateAccelerations(const double time, const std::vector<int>& active) override {
+        // the source moves on its own clock here, since substeps don't line up with the stage times above
+        if (blockTime >= 0.0)
+            pointSourceLocation += pointSourceVelocity * (time - blockTime);
+        blockTime = time;
+
+        NodeList* nodeList = this->nodeList;
+        PhysicalConstants constants = this->constants;
+        VectorField* position       = nodeList->getField<Vector>("position");
+        VectorField* acceleration   = nodeList->getField<Vector>("acceleration");
+
+        #pragma omp parallel for
+        for (int k=0; k<(int)active.size(); ++k) {
+            Vector r = (pointSourceLocation - position->getValue(active[k]));
+            acceleration->setValue(active[k], pointSourceMass*constants.G()/(r.mag2())*r.normal());
+        }
+    }
+
+    virtual double
+    NodeTimestep(const Vector& v, const Vector& a) const override {
+        return 1e-4*sqrt(v.mag2()/a.mag2());
+    }
+
     virtual std::string name() const override { return "pointSourceGravity"; }
     virtual std::string description() const override {
         return "Point source gravity physics package for particles"; }
@@ -0,0 +1,47 @@
+// Copyright (C) 2025  Cody Raskin
+
+#pragma once
+
+#include "physics.hh"
+#include <string>
+
+// A package whose state is a displacement q and its rate p = dq/dt, with dp/dt a function
+// of q (plus terms local to a node), like the wave equation. LeapfrogIntegrator advances
+// such a package in place on the nodeList's own fields rather than through State copies:
+// each step kicks p and then drifts q with the new p, so p lives at the half steps.
+template <int dim>
+class SecondOrderPhysics : public Physics<dim> {
+public:
+    SecondOrderPhysics(NodeList* nodeList, PhysicalConstants& constants) :
+        Physics<dim>(nodeList,constants) {}
+
+    virtual ~SecondOrderPhysics() {}
+
+    // p += kickDt dp/dt(q), then q += dt p, where kickDt is the mean of this step and the
+    // last one (half of dt on the first step). Also leaves EstimateTimestep up to date.
+    virtual void
+    Leapfrog(const double dt, const double kickDt) = 0;
+
+    // called after Leapfrog in place of ApplyBoundaries and FinalizeStep
+    virtual void
+    FinalizeLeapfrog() {
+        State<dim> inPlace = InPlaceState();
+        this->ApplyBoundaries(&inPlace);
+        this->FinalChecks();
+    }
+
+    // the package's state fields as the nodeList holds them, shared rather than copied
+    State<dim>
+    InPlaceState() {
+        State<dim> inPlace(this->nodeList->size());
+        for (int f = 0; f < this->state.count(); ++f) {
+            FieldBase* field = this->state.getFieldByIndex(f);
+            const std::string name = field->getNameString();
+            if (dynamic_cast<Field<double>*>(field))
+                inPlace.template shareField<double>(this->nodeList->template getField<double>(name));
+            else if (dynamic_cast<Field<Lin::Vector<dim>>*>(field))
+                inPlace.template shareField<Lin::Vector<dim>>(this->nodeList->template getField<Lin::Vector<dim>>(name));
+        }
+        return inPlace;
+    }
+};
@@ -4,7 +4,16 @@
 #include "../EOS/equationOfState.hh"
 #include "../EOS/opacityModel.hh"
 #include "../Mesh/grid.hh"
-
+#include "../Math/conjugateGradient.hh"
+#include <stdexcept>
+
+// Conduction on a grid, either explicit (limited to dt ~ dx^2/D) or implicit.
+// The implicit methods ("backwardEuler", "crankNicolson") solve for the new temperatures
+// once per step in PreStepInitialize: Newton iterations on rho (u(T) - u^n)/dt = theta L(T)
+// + (1-theta) L(T^n), with cv and the conductivity re-evaluated at every iterate and each
+// linear solve done matrix-free with Jacobi-preconditioned CG. EvaluateDerivatives then just
+// hands back (u^{n+1} - u^n)/dt, so any integrator reproduces the implicit update.
+// Boundary cells are held fixed, as in the explicit update.
 template <int dim>
 class ThermalConduction : public Physics<dim> {
 protected:
@@ -12,17 +21,56 @@ protected:
     EquationOfState* eos;
     OpacityModel* opac;
     double dtmin;
+
+    std::string method;
+    bool implicit = false;
+    double theta = 1.0;
+    double newtonTolerance = 1e-6;
+    double cgTolerance = 1e-8;
+    int maxNewtonIterations = 10;
+    int maxCGIterations = 500;
+    int lastNewtonIterations = 0;
+    int lastCGIterations = 0;
+    double maxTemperatureChange = 0.1;   // relative change per step the implicit dt aims for
+    double lastChange = 0.0;
+
+    // face stencil, built once: neighbors of cell i are nbrIndex[nbrOffset[i]..nbrOffset[i+1]),
+    // each with its faceArea/distance
+    std::vector<int> nbrOffset, nbrIndex;
+    std::vector<double> nbrGeometry;
+    std::vector<char> interior;
+    std::vector<double> du;
+
+    // cv and the perturbed temperature/energy used to difference it, filled once per stage
+    Field<double> cv, tPlus, uPlus;
 public:
     using Vector = Lin::Vector<dim>;
     using VectorField = Field<Vector>;
     using ScalarField = Field<double>;
 
-    ThermalConduction(NodeList* nodeList, PhysicalConstants& constants, EquationOfState* eos, OpacityModel* opac, Mesh::Grid<dim>* grid) : 
-        Physics<dim>(nodeList,constants), eos(eos), grid(grid), opac(opac) {
+    ThermalConduction(NodeList* nodeList, PhysicalConstants& constants, EquationOfState* eos, OpacityModel* opac, Mesh::Grid<dim>* grid, std::string method) :
+        Physics<dim>(nodeList,constants), eos(eos), grid(grid), opac(opac), method(method) {
+        if (method == "backwardEuler")
+            theta = 1.0;
+        else if (method == "crankNicolson")
+            theta = 0.5;
+        else if (method != "explicit")
+            throw std::invalid_argument("ThermalConduction: method must be explicit, backwardEuler or crankNicolson");
+        implicit = (method != "explicit");
+
         VerifyFields(nodeList);
         grid->assignPositions(nodeList);
+        BuildStencil();
+
+        int numZones = nodeList->size();
+        cv    = ScalarField("cv", numZones);
+        tPlus = ScalarField("tPlus", numZones);
+        uPlus = ScalarField("uPlus", numZones);
     }
 
+    ThermalConduction(NodeList* nodeList, PhysicalConstants& constants, EquationOfState* eos, OpacityModel* opac, Mesh::Grid<dim>* grid) :
+        ThermalConduction(nodeList, constants, eos, opac, grid, "explicit") {}
+
     virtual ~ThermalConduction() {}
 
     virtual void
@@ -33,25 +81,18 @@ public:
     }
 
     void SetConductivity() {
-        int numZones = this->nodeList->size();
-
-        ScalarField* rho           = this->nodeList->template getField<double>("density");
-        ScalarField* u             = this->nodeList->template getField<double>("specificInternalEnergy");
-        ScalarField* T             = this->nodeList->template getField<double>("temperature");
-        ScalarField* X             = this->nodeList->template getField<double>("conductivity");
-        // looping and using scalar methods for speed
-        for (int i = 0 ; i < numZones ; ++i) SetConductivity(rho,u,T,X,i);
+        UpdateCache(this->nodeList->template getField<double>("specificInternalEnergy"));
     }
 
-    void SetConductivity(ScalarField* rho, ScalarField* u, ScalarField* T, ScalarField* X, int i) {
-        double rhoi = rho->getValue(i);
-        double ui   = u->getValue(i);
-        double Ti   = T->getValue(i);
-        double Xi   = X->getValue(i);
-        eos->setTemperature(&Ti, &rhoi, &ui);
-        T->setValue(i, Ti);
-        opac->setConductivity(&Xi, &rhoi, &Ti);
-        X->setValue(i, Xi);
+    // temperature, conductivity and cv for every cell at the energies u, each from a
+    // single batched EOS/opacity call, so the stencil loops only read cached arrays
+    void UpdateCache(ScalarField* u) {
+        ScalarField* rho = this->nodeList->template getField<double>("density");
+        ScalarField* T   = this->nodeList->template getField<double>("temperature");
+        ScalarField* X   = this->nodeList->template getField<double>("conductivity");
+        eos->setTemperature(EquationOfState::data(T), EquationOfState::data(rho), EquationOfState::data(u), T->size());
+        opac->setConductivity(X, rho, T);
+        SpecificHeat(T, u);
     }
 
     virtual void ZeroTimeInitialize() override {
@@ -62,6 +103,8 @@ public:
 
     virtual void PreStepInitialize() override {
         SetConductivity();
+        if (implicit && this->stepDt > 0.0)
+            ImplicitSolve(this->stepDt);
         this->state.updateFields(this->nodeList);
     }
 
@@ -75,61 +118,39 @@ public:
 
         ScalarField* dudt   = deriv.template getField<double>("specificInternalEnergy");
 
+        if (implicit) {
+            // the step was already taken in PreStepInitialize
+            #pragma omp parallel for
+            for (int i = 0 ; i < numZones ; ++i)
+                dudt->setValue(i, (this->stepDt > 0.0 && i < (int)du.size() ? du[i] / this->stepDt : 0.0));
+            this->lastDt = dt;
+            return;
+        }
+
+        UpdateCache(u);
+        const std::vector<double>& Tv = T->getValues();
+        const std::vector<double>& Xv = X->getValues();
+
         double local_dtmin = 1e30;
         double dx2 = grid->getdx() * grid->getdx();  // assume uniform dx for now
 
         #pragma omp parallel for reduction(min:local_dtmin)
         for (int i = 0 ; i < numZones ; ++i) {
-            if (!grid->onBoundary(i)) {
-                const Vector& ri = grid->getPosition(i);
-                double Vi = grid->cellVolume(i);
-                double divFlux = 0.0;
-                double Xi = X->getValue(i);
-                double Ti = T->getValue(i);
-
-                SetConductivity(rho,u,T,X,i);
-
-                for (int j : grid->neighbors(i)) {
-                    if (j < 0 || j >= numZones || j == i) continue;
-
-                    double Xj = X->getValue(j);
-                    double Tj = T->getValue(j);
+            if (!interior[i]) continue;
 
-                    const Vector& rj = grid->getPosition(j);
-                    Vector dx = rj - ri;
-                    double dist2 = dx.mag2();
-                    if (dist2 == 0.0) continue;
+            double rhoi = rho->getValue(i);
+            dudt->setValue(i, Conduction(i, Tv, Xv) / (rhoi * grid->cellVolume(i)));
 
-                    double Tij = Tj-Ti;
-                    double Xij = 0.5 * (Xi+Xj);  // symmetric average
+            // Clamp or skip invalid results
+            double cvi = cv[i];
+            if (cvi <= 0.0 || std::isnan(cvi) || std::isinf(cvi)) continue;
 
-                    double flux = -Xij * Tij / std::sqrt(dist2);  // scalar flux across face
-                    double Aij = grid->faceArea(i, j);            // effective area between i and j
+            double D = Xv[i] / (rhoi * cvi);
+            if (D <= 0.0 || std::isnan(D) || std::isinf(D)) continue;
 
-                    divFlux += flux * Aij;
-                }
-
-                dudt->setValue(i,divFlux / Vi);
-
-                double rhoi = rho->getValue(i);  // density
-
-                // Approximate cv = du/dT numerically:
-                double ui = u->getValue(i);
-                double dT = std::max(std::abs(Ti) * 1e-4, 1e-10);
-                double ui_plus, Ti_plus = Ti + dT;
-                eos->setInternalEnergyFromTemperature(&ui_plus, &rhoi, &Ti_plus);
-                double cv = (ui_plus - ui) / dT;
-
-                // Clamp or skip invalid results
-                if (cv <= 0.0 || std::isnan(cv) || std::isinf(cv)) continue;
-
-                double D = Xi / (rhoi * cv);
-                if (D <= 0.0 || std::isnan(D) || std::isinf(D)) continue;
-
-                double dt_candidate = 0.5 * dx2 / D;
-                if (dt_candidate > 0.0)
-                    local_dtmin = std::min(local_dtmin, dt_candidate);
-            }
+            double dt_candidate = 0.5 * dx2 / D;
+            if (dt_candidate > 0.0)
+                local_dtmin = std::min(local_dtmin, dt_candidate);
         }
         dtmin = local_dtmin;
 
@@ -138,6 +159,12 @@ public:
     }
 
     virtual double EstimateTimestep() const override {
+        if (implicit) {
+            // no stability limit, so grow or shrink dt to keep the temperature change in check
+            if (this->stepDt <= 0.0) return 1e30;
+            double factor = (lastChange > 0.0 ? maxTemperatureChange / lastChange : 2.0);
+            return this->stepDt * std::min(2.0, factor);
+        }
         double timestepCoefficient = 0.25; // Adjust as needed
         double timestep = timestepCoefficient * std::sqrt(dtmin);
 
@@ -150,7 +177,155 @@ public:
         return field->getValue(idx);
     }
 
+    inline std::string getMethod() const { return method; }
+    inline double getNewtonTolerance() const { return newtonTolerance; }
+    inline void setNewtonTolerance(const double value) { newtonTolerance = value; }
+    inline double getCGTolerance() const { return cgTolerance; }
+    inline void setCGTolerance(const double value) { cgTolerance = value; }
+    inline int getMaxNewtonIterations() const { return maxNewtonIterations; }
+    inline void setMaxNewtonIterations(const int value) { maxNewtonIterations = value; }
+    inline int getMaxCGIterations() const { return maxCGIterations; }
+    inline void setMaxCGIterations(const int value) { maxCGIterations = value; }
+    inline double getMaxTemperatureChange() const { return maxTemperatureChange; }
+    inline void setMaxTemperatureChange(const double value) { maxTemperatureChange = value; }
+    inline int getLastNewtonIterations() const { return lastNewtonIterations; }
+    inline int getLastCGIterations() const { return lastCGIterations; }
+
     virtual std::string name() const override { return "ThermalConduction"; }
     virtual std::string description() const override {
         return "Thermal conduction physics"; }
-};
\ No newline at end of file
+
+protected:
+    void
+    BuildStencil() {
+        const int numZones = grid->size();
+        nbrOffset.assign(1, 0);
+        nbrIndex.clear();
+        nbrGeometry.clear();
+        interior.resize(numZones);
+        for (int i = 0 ; i < numZones ; ++i) {
+            interior[i] = !grid->onBoundary(i);
+            const Vector ri = grid->getPosition(i);
+            for (int j : grid->neighbors(i)) {
+                if (j < 0 || j >= numZones || j == i) continue;
+                double dist = (grid->getPosition(j) - ri).magnitude();
+                if (dist == 0.0) continue;
+                nbrIndex.push_back(j);
+                nbrGeometry.push_back(grid->faceArea(i, j) / dist);
+            }
+            nbrOffset.push_back(nbrIndex.size());
+        }
+    }
+
+    // cv = du/dT at (T, u) into the cache, approximated numerically with one batched EOS call
+    void
+    SpecificHeat(ScalarField* T, ScalarField* u) {
+        const int numZones = T->size();
+        ScalarField* rho = this->nodeList->template getField<double>("density");
+        #pragma omp parallel for
+        for (int i = 0 ; i < numZones ; ++i)
+            tPlus[i] = (*T)[i] + std::max(std::abs((*T)[i]) * 1e-4, 1e-10);
+        eos->setInternalEnergyFromTemperature(EquationOfState::data(&uPlus), EquationOfState::data(rho), EquationOfState::data(&tPlus), numZones);
+        #pragma omp parallel for
+        for (int i = 0 ; i < numZones ; ++i)
+            cv[i] = (uPlus[i] - (*u)[i]) / (tPlus[i] - (*T)[i]);
+    }
+
+    // sum_j (faceArea/dist) Xij (T_j - T_i) for an interior cell: the heating rate times its volume
+    double
+    Conduction(int i, const std::vector<double>& T, const std::vector<double>& X) const {
+        double q = 0.0;
+        for (int n = nbrOffset[i]; n < nbrOffset[i + 1]; ++n) {
+            int j = nbrIndex[n];
+            q += nbrGeometry[n] * 0.5 * (X[i] + X[j]) * (T[j] - T[i]);
+        }
+        return q;
+    }
+
+    void
+    ImplicitSolve(const double dt) {
+        const int numZones = this->nodeList->size();
+        ScalarField* rho = this->nodeList->template getField<double>("density");
+        ScalarField* u   = this->nodeList->template getField<double>("specificInternalEnergy");
+        ScalarField* T   = this->nodeList->template getField<double>("temperature");
+        ScalarField* X   = this->nodeList->template getField<double>("conductivity");
+
+        std::vector<double> T0(T->getValues().begin(), T->getValues().end());
+        ScalarField Tk("Tk", numZones), Xk("Xk", numZones), uk("uk", numZones);
+        Tk.copyValues(T);
+        Xk.copyValues(X);
+        std::vector<double> mass(numZones), diag(numZones), rhs(numZones), delta(numZones);
+        std::vector<double> explicitPart(numZones, 0.0);
+
+        #pragma omp parallel for
+        for (int i = 0 ; i < numZones ; ++i) {
+            mass[i] = rho->getValue(i) * grid->cellVolume(i);
+            if (interior[i] && theta < 1.0)
+                explicitPart[i] = (1.0 - theta) * Conduction(i, T0, Xk.getValues());
+        }
+
+        // J delta = diag delta - theta sum_j cij delta_j, with the fixed boundary cells
+        // reduced to the identity so J stays symmetric
+        auto apply = [&](const std::vector<double>& x, std::vector<double>& y) {
+            #pragma omp parallel for
+            for (int i = 0 ; i < numZones ; ++i) {
+                if (!interior[i]) { y[i] = x[i]; continue; }
+                double off = 0.0;
+                for (int n = nbrOffset[i]; n < nbrOffset[i + 1]; ++n) {
+                    int j = nbrIndex[n];
+                    if (interior[j])
+                        off += nbrGeometry[n] * 0.5 * (Xk[i] + Xk[j]) * x[j];
+                }
+                y[i] = diag[i] * x[i] - theta * off;
+            }
+        };
+        auto jacobi = [&](const std::vector<double>& r, std::vector<double>& z) {
+            #pragma omp parallel for
+            for (int i = 0 ; i < numZones ; ++i)
+                z[i] = r[i] / diag[i];
+        };
+
+        lastCGIterations = 0;
+        lastNewtonIterations = 0;
+        for (int newton = 0; newton < maxNewtonIterations; ++newton) {
+            eos->setInternalEnergyFromTemperature(EquationOfState::data(&uk), EquationOfState::data(rho), EquationOfState::data(&Tk), numZones);
+            opac->setConductivity(&Xk, rho, &Tk);
+            SpecificHeat(&Tk, &uk);
+            #pragma omp parallel for
+            for (int i = 0 ; i < numZones ; ++i) {
+                if (!interior[i]) {
+                    diag[i] = 1.0;
+                    rhs[i] = 0.0;
+                    continue;
+                }
+                double cvi = std::max(cv[i], 1e-300);
+                double sumC = 0.0;
+                for (int n = nbrOffset[i]; n < nbrOffset[i + 1]; ++n)
+                    sumC += nbrGeometry[n] * 0.5 * (Xk[i] + Xk[nbrIndex[n]]);
+                diag[i] = mass[i] * cvi / dt + theta * sumC;
+                rhs[i] = -(mass[i] * (uk[i] - u->getValue(i)) / dt
+                           - theta * Conduction(i, Tk.getValues(), Xk.getValues()) - explicitPart[i]);
+            }
+
+            std::fill(delta.begin(), delta.end(), 0.0);
+            lastCGIterations += Lin::pcg(apply, jacobi, rhs, delta, cgTolerance, maxCGIterations);
+            lastNewtonIterations++;
+
+            double change = 0.0;
+            for (int i = 0 ; i < numZones ; ++i) {
+                Tk[i] += delta[i];
+                change = std::max(change, std::abs(delta[i]) / std::max(std::abs(Tk[i]), 1e-300));
+            }
+            if (change < newtonTolerance) break;
+        }
+
+        eos->setInternalEnergyFromTemperature(EquationOfState::data(&uk), EquationOfState::data(rho), EquationOfState::data(&Tk), numZones);
+        du.assign(numZones, 0.0);
+        lastChange = 0.0;
+        for (int i = 0 ; i < numZones ; ++i) {
+            if (!interior[i]) continue;
+            du[i] = uk[i] - u->getValue(i);
+            lastChange = std::max(lastChange, std::abs(Tk[i] - T0[i]) / std::max(std::abs(T0[i]), 1e-300));
+        }
+    }
+};
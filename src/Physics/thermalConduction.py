@@ -10,9 +10,26 @@ class ThermalConduction(Physics):
                opac="OpacityModel*",
                grid="Mesh::Grid<%(dim)s>*"):
         return
+    def pyinit1(self,
+               nodeList="NodeList*",
+               constants="PhysicalConstants&",
+               eos="EquationOfState*",
+               opac="OpacityModel*",
+               grid="Mesh::Grid<%(dim)s>*",
+               method="std::string"):
+        "method is explicit, backwardEuler or crankNicolson"
+        return
     @PYB11cppname("getCell")
     def getCell2d(self,i="int",j="int",fieldName="std::string"):
         return
+    method = PYB11property("std::string", getter="getMethod", doc="Time discretization of the conduction term.")
+    newtonTolerance = PYB11property("double", getter="getNewtonTolerance", setter="setNewtonTolerance", doc="Relative temperature update the Newton iterations stop at.")
+    cgTolerance = PYB11property("double", getter="getCGTolerance", setter="setCGTolerance", doc="Residual reduction each CG solve stops at.")
+    maxNewtonIterations = PYB11property("int", getter="getMaxNewtonIterations", setter="setMaxNewtonIterations")
+    maxCGIterations = PYB11property("int", getter="getMaxCGIterations", setter="setMaxCGIterations")
+    maxTemperatureChange = PYB11property("double", getter="getMaxTemperatureChange", setter="setMaxTemperatureChange", doc="Relative temperature change per step the implicit timestep aims for.")
+    lastNewtonIterations = PYB11property("int", getter="getLastNewtonIterations")
+    lastCGIterations = PYB11property("int", getter="getLastCGIterations")
 
 ThermalConduction1d = PYB11TemplateClass(ThermalConduction,
                               template_parameters = ("1"),
@@ -0,0 +1,219 @@
+// Copyright (C) 2025  Cody Raskin
+
+#include "kinematics.hh"
+#include "../Math/alignedAllocator.hh"
+#include <iostream>
+
+// Direct-summation gravity with the same force law as NBodyGravity, but laid out for the hardware:
+// positions and masses are copied into aligned SoA buffers and the pair loop runs over
+// L1-sized tiles with a SIMD inner loop. In symmetric mode each pair is visited once and
+// the reaction force is scattered into per-thread partial sums (Newton's third law).
+template <int dim>
+class TiledNBodyGravity : public Kinematics<dim> {
+protected:
+    double dtmin;
+    double plummerLength;
+    bool symmetric;
+    static constexpr int tileSize = 256;
+
+    std::array<Lin::AlignedVector<double>, dim> xs, as;
+    Lin::AlignedVector<double> ms;
+public:
+    using Vector = Lin::Vector<dim>;
+    using VectorField = Field<Vector>;
+    using ScalarField = Field<double>;
+
+    TiledNBodyGravity(NodeList* nodeList, PhysicalConstants& constants, double plummerLength, bool symmetric) :
+        Kinematics<dim>(nodeList,constants),
+        plummerLength(plummerLength),
+        symmetric(symmetric) {}
+
+    TiledNBodyGravity(NodeList* nodeList, PhysicalConstants& constants, double plummerLength) :
+        TiledNBodyGravity(nodeList, constants, plummerLength, true) {}
+
+    ~TiledNBodyGravity() {}
+
+    virtual void
+    EvaluateDerivatives(const State<dim>* initialState, State<dim>& deriv, const double time, const double dt) override {
+        NodeList* nodeList = this->nodeList;
+        PhysicalConstants constants = this->constants;
+        int numNodes = nodeList->size();
+
+        ScalarField* mass           = nodeList->getField<double>("mass");
+        VectorField* position       = initialState->template getField<Vector>("position");
+        VectorField* acceleration   = nodeList->getField<Vector>("acceleration");
+        VectorField* velocity       = initialState->template getField<Vector>("velocity");
+
+        VectorField* dxdt           = deriv.template getField<Vector>("position");
+        VectorField* dvdt           = deriv.template getField<Vector>("velocity");
+
+        LoadSoA(position, mass);
+        if (symmetric)
+            SymmetricForces(numNodes);
+        else {
+            std::vector<int> targets(numNodes);
+            for (int i = 0; i < numNodes; ++i) targets[i] = i;
+            GatherForces(targets, numNodes);
+        }
+
+        const double G = constants.G();
+        double local_dtmin = 1e30;
+
+        #pragma omp parallel for reduction(min:local_dtmin)
+        for (int i=0; i<numNodes ; ++i) {
+            Vector a;
+            for (int d = 0; d < dim; ++d)
+                a[d] = G*as[d][i];
+            Vector v = velocity->getValue(i);
+            acceleration->setValue(i,a);
+            double amag = a.mag2();
+            double vmag = v.mag2();
+            local_dtmin = std::min(local_dtmin,vmag/amag);
+            dxdt->setValue(i,v+dt*a);
+            dvdt->setValue(i,a);
+        }
+        dtmin  = local_dtmin;
+        this->lastDt = dt;
+    }
+
+    virtual double
+    EstimateTimestep() const override {
+        double timestepCoefficient = 1e-2; // Adjust as needed
+        double timestep = timestepCoefficient * sqrt(dtmin);
+
+        return timestep;
+    }
+
+    // a subset can't use the symmetric kernel, so active nodes always gather
+    virtual void
+    EvaluateAccelerations(const double time, const std::vector<int>& active) override {
+        NodeList* nodeList = this->nodeList;
+        ScalarField* mass           = nodeList->getField<double>("mass");
+        VectorField* position       = nodeList->getField<Vector>("position");
+        VectorField* acceleration   = nodeList->getField<Vector>("acceleration");
+
+        LoadSoA(position, mass);
+        GatherForces(active, nodeList->size());
+
+        const double G = this->constants.G();
+        #pragma omp parallel for
+        for (int k = 0; k < (int)active.size(); ++k) {
+            Vector a;
+            for (int d = 0; d < dim; ++d)
+                a[d] = G*as[d][active[k]];
+            acceleration->setValue(active[k], a);
+        }
+    }
+
+    virtual double
+    NodeTimestep(const Vector& v, const Vector& a) const override {
+        return 1e-2*sqrt(v.mag2()/a.mag2());
+    }
+
+    inline bool isSymmetric() const { return symmetric; }
+
+    virtual std::string name() const override { return "tiledNBodyGravity"; }
+    virtual std::string description() const override {
+        return "Tiled SIMD direct-summation gravity for particles"; }
+
+protected:
+    void
+    LoadSoA(VectorField* position, ScalarField* mass) {
+        const int numNodes = position->size();
+        ms.resize(numNodes);
+        for (int d = 0; d < dim; ++d) {
+            xs[d].resize(numNodes);
+            as[d].assign(numNodes, 0.0);
+        }
+        #pragma omp parallel for
+        for (int i = 0; i < numNodes; ++i) {
+            const Vector& xi = position->getValue(i);
+            for (int d = 0; d < dim; ++d)
+                xs[d][i] = xi[d];
+            ms[i] = mass->getValue(i);
+        }
+    }
+
+    // every target gathers from every j; no shared writes, so target tiles are simply split across threads
+    void
+    GatherForces(const std::vector<int>& targets, const int numNodes) {
+        const double eps = plummerLength;
+        const double* m = ms.data();
+        std::array<const double*, dim> x;
+        for (int d = 0; d < dim; ++d) x[d] = xs[d].data();
+
+        const int numTargets = targets.size();
+        const int numTiles = (numNodes + tileSize - 1)/tileSize;
+        const int numTargetTiles = (numTargets + tileSize - 1)/tileSize;
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (int it = 0; it < numTargetTiles; ++it) {
+            const int k0 = it*tileSize, k1 = std::min(numTargets, k0 + tileSize);
+            for (int jt = 0; jt < numTiles; ++jt) {
+                const int j0 = jt*tileSize, j1 = std::min(numNodes, j0 + tileSize);
+                for (int k = k0; k < k1; ++k) {
+                    const int i = targets[k];
+                    double xi[dim], ai[dim];
+                    for (int d = 0; d < dim; ++d) { xi[d] = x[d][i]; ai[d] = 0.0; }
+
+                    #pragma omp simd reduction(+:ai[:dim])
+                    for (int j = j0; j < j1; ++j) {
+                        double rij[dim], r2 = 0.0;
+                        for (int d = 0; d < dim; ++d) { rij[d] = x[d][j] - xi[d]; r2 += rij[d]*rij[d]; }
+                        // r2 == 0 only for j == i (or coincident bodies), which feel nothing
+                        double f = (r2 > 0.0 ? m[j]/(std::sqrt(r2)*(r2 + eps)) : 0.0);
+                        for (int d = 0; d < dim; ++d) ai[d] += f*rij[d];
+                    }
+                    for (int d = 0; d < dim; ++d) as[d][i] += ai[d];
+                }
+            }
+        }
+    }
+
+    // each pair once: i takes +m_j f r_ij and j takes -m_i f r_ij into this thread's partial sums
+    void
+    SymmetricForces(const int numNodes) {
+        const double eps = plummerLength;
+        const double* m = ms.data();
+        std::array<const double*, dim> x;
+        for (int d = 0; d < dim; ++d) x[d] = xs[d].data();
+
+        const int numTiles = (numNodes + tileSize - 1)/tileSize;
+        #pragma omp parallel
+        {
+            std::array<Lin::AlignedVector<double>, dim> partial;
+            for (int d = 0; d < dim; ++d) partial[d].assign(numNodes, 0.0);
+
+            #pragma omp for schedule(dynamic, 1)
+            for (int it = 0; it < numTiles; ++it) {
+                const int i0 = it*tileSize, i1 = std::min(numNodes, i0 + tileSize);
+                for (int jt = it; jt < numTiles; ++jt) {
+                    const int j0 = jt*tileSize, j1 = std::min(numNodes, j0 + tileSize);
+                    for (int i = i0; i < i1; ++i) {
+                        double xi[dim], ai[dim];
+                        for (int d = 0; d < dim; ++d) { xi[d] = x[d][i]; ai[d] = 0.0; }
+                        const double mi = m[i];
+                        std::array<double*, dim> aj;
+                        for (int d = 0; d < dim; ++d) aj[d] = partial[d].data();
+
+                        #pragma omp simd reduction(+:ai[:dim])
+                        for (int j = (jt == it ? i + 1 : j0); j < j1; ++j) {
+                            double rij[dim], r2 = 0.0;
+                            for (int d = 0; d < dim; ++d) { rij[d] = x[d][j] - xi[d]; r2 += rij[d]*rij[d]; }
+                            double f = (r2 > 0.0 ? 1.0/(std::sqrt(r2)*(r2 + eps)) : 0.0);
+                            for (int d = 0; d < dim; ++d) {
+                                ai[d]    += m[j]*f*rij[d];
+                                aj[d][j] -= mi*f*rij[d];
+                            }
+                        }
+                        for (int d = 0; d < dim; ++d) partial[d][i] += ai[d];
+                    }
+                }
+            }
+
+            #pragma omp critical
+            for (int d = 0; d < dim; ++d)
+                for (int i = 0; i < numNodes; ++i)
+                    as[d][i] += partial[d][i];
+        }
+    }
+};
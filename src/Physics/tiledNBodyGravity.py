@@ -0,0 +1,34 @@
+from PYB11Generator import *
+from physics import *
+
+@PYB11template("dim")
+class TiledNBodyGravity(Physics):
+    def pyinit(self,
+               nodeList="NodeList*",
+               constants="PhysicalConstants&",
+               plummerLength="double"):
+        return
+    def pyinit1(self,
+               nodeList="NodeList*",
+               constants="PhysicalConstants&",
+               plummerLength="double",
+               symmetric="bool"):
+        "Symmetric mode visits each pair once and applies Newton's third law"
+        return
+    symmetric = PYB11property("bool", getter="isSymmetric", doc="Whether each pair is visited once.")
+
+TiledNBodyGravity1d = PYB11TemplateClass(TiledNBodyGravity,
+                              template_parameters = ("1"),
+                              cppname = "TiledNBodyGravity<1>",
+                              pyname = "TiledNBodyGravity1d",
+                              docext = " (1D).")
+TiledNBodyGravity2d = PYB11TemplateClass(TiledNBodyGravity,
+                              template_parameters = ("2"),
+                              cppname = "TiledNBodyGravity<2>",
+                              pyname = "TiledNBodyGravity2d",
+                              docext = " (2D).")
+TiledNBodyGravity3d = PYB11TemplateClass(TiledNBodyGravity,
+                              template_parameters = ("3"),
+                              cppname = "TiledNBodyGravity<3>",
+                              pyname = "TiledNBodyGravity3d",
+                              docext = " (3D).")
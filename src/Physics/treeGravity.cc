@@ -68,6 +68,32 @@ public:
         return timestepCoefficient * dtmin;
     }
 
+    virtual void
+    EvaluateAccelerations(const double time, const std::vector<int>& active) override {
+        NodeList* nodeList = this->nodeList;
+        ScalarField* mass           = nodeList->getField<double>("mass");
+        VectorField* position       = nodeList->getField<Vector>("position");
+        VectorField* acceleration   = nodeList->getField<Vector>("acceleration");
+
+        // the tree is over everyone's predicted positions, but only the active nodes walk it
+        SpatialTree<dim> tree(position, mass);
+        tree.build();
+
+        double theta = 0.5;
+        double eps2 = plummerLength;
+        const double G = this->constants.G();
+
+        #pragma omp parallel for
+        for (int k = 0; k < (int)active.size(); ++k)
+            acceleration->setValue(active[k], tree.computeForceOn(active[k], theta, G, eps2));
+    }
+
+    virtual double
+    NodeTimestep(const Vector& v, const Vector& a) const override {
+        double amag = a.mag2();
+        return (amag > 0.0 ? 0.1 * v.mag2() / amag : 1e30);
+    }
+
     virtual std::string name() const override { return "treeGravity"; }
     virtual std::string description() const override {
         return "Barnes-Hut tree-based gravity for N-body simulations";
@@ -1,12 +1,39 @@
 // Copyright (C) 2025  Cody Raskin
 
-#include "physics.hh"
+#include "secondOrderPhysics.hh"
 #include "../Mesh/grid.hh"
+#include "../Mesh/activeBlocks.hh"
 #include "../IO/importDepthMap.hh"
+#include "../Boundaries/absorbingGridBoundary.cc"
 #include <iostream>
-
+#include <memory>
+
+// The diagnostics (maxphi, phisq, waveEnergyDensity) and soundSpeed are read or written
+// once per cell per stage and never integrated, so with precision "single" they are
+// stored as floats, cutting the memory traffic of a stage; phi and xi stay double.
+//
+// With active tracking on, only the blocks of cells near those whose phi or xi moved by
+// more than activityTolerance over the last step, or that this package's own derivatives
+// would have moved by that much, are evaluated, so a localized source or an expanding
+// front costs what the disturbed region costs. The second test keeps a cell that another
+// package holds still from losing its own terms.
+//
+// The cells evaluated are kept in one compact list, in index order, with their 2*dim
+// neighbors looked up once. In ocean mode land cells (depth >= 0) are left out of it
+// altogether, and a wet cell's neighbor on land is replaced by the cell itself, which
+// makes the coastline a reflecting face.
+//
+// The cells of any AbsorbingGridBoundary added to the package become a perfectly matched
+// layer, with its profile scaled by the local sound speed. The auxiliary fields psi (and
+// in 3D Phi) are kept only on the layer cells and advanced once per step.
+//
+// Under LeapfrogIntegrator the package steps itself in place with one sweep of the list:
+// each cell's xi is kicked as soon as its neighbors are read, and its phi drifted once the
+// sweep is a full stride past it, when no cell left reads its old value. The list is cut
+// into chunks that sweep in parallel; the cells within a stride of either end of a chunk
+// are read by the next chunk over, so they are drifted after all the chunks are through.
 template <int dim>
-class WaveEquation : public Physics<dim> {
+class WaveEquation : public SecondOrderPhysics<dim> {
 protected:
     Mesh::Grid<dim>* grid;
     Mesh::Grid<2>* grid2d;
@@ -14,31 +41,53 @@ protected:
     double C;
     double dtmin;
     double dxmin = 1e30;
-    std::vector<int> insideIds;
+    Precision precision;
+    std::vector<int> insideIds;                 // inside wet cells
+    std::vector<int> stencil;                   // 2*dim per inside cell: -, + along each axis
+    std::vector<int> chunkStart;                // leapfrog chunks of insideIds
+    int maxStride = 1;                          // farthest a stencil reaches in index
+    std::vector<int> layerIds;                  // inside cells in or next to an absorbing layer
+    std::vector<int> layerInside;               // their positions in insideIds
+    std::vector<int> layerOf;                   // per inside cell: its position in layerIds, or -1
+    std::vector<int> layerStencil;              // 2*dim per layer cell: neighbors' positions here, or -1
+    std::vector<double> layerProfile;           // dim per layer cell: sigma_k / c
+    std::vector<double> psi, Phi;               // auxiliary fields, on the layer cells only
+    std::vector<double> layerGrad, layerPhi;    // grad phi and phi there at the start of the step
+    bool activeTracking = false;
+    double activityTolerance = 0.0;
+    int activeBlockSize = 16;
+    std::unique_ptr<Mesh::ActiveBlocks<dim>> activity;
+    std::vector<double> lastPhi, lastXi, cellDt;
+    std::vector<char> driven;                   // this package moved the cell last step
 public:
     using Vector = Lin::Vector<dim>;
     using VectorField = Field<Vector>;
     using ScalarField = Field<double>;
 
-    WaveEquation(NodeList* nodeList, PhysicalConstants& constants, Mesh::Grid<dim>* grid, double C) : 
-        Physics<dim>(nodeList,constants),
-        grid(grid), C(C) {
+    WaveEquation(NodeList* nodeList, PhysicalConstants& constants, Mesh::Grid<dim>* grid, double C,
+                 const std::string& precision = "double") : 
+        SecondOrderPhysics<dim>(nodeList,constants),
+        grid(grid), C(C), precision(ParsePrecision(precision)) {
         VerifyWaveFields();
 
         grid->assignPositions(nodeList);
 
-        ScalarField* cs = nodeList->getField<double>("soundSpeed");
-        for (int i=0; i<nodeList->getNumNodes();++i) cs->setValue(i,C);
+        this->WithScalarField("soundSpeed", [&](auto* cs) {
+            for (int i=0; i<nodeList->getNumNodes();++i) cs->setValue(i,C);
+        });
         for (int i = 0; i < dim; ++i)
             dxmin = std::min(dxmin, grid->spacing(i));
     }
 
-    WaveEquation(NodeList* nodeList, PhysicalConstants& constants, Mesh::Grid<2>* grid, const std::string& depthMap) : 
-        Physics<dim>(nodeList, constants),
-        grid2d(grid), C(constants.ESurfaceGrav()), ocean(true) {
-        if (dim != 2) {
+    WaveEquation(NodeList* nodeList, PhysicalConstants& constants, Mesh::Grid<2>* grid, const std::string& depthMap,
+                 const std::string& precision = "double") : 
+        SecondOrderPhysics<dim>(nodeList, constants),
+        grid2d(grid), C(constants.ESurfaceGrav()), ocean(true), precision(ParsePrecision(precision)) {
+        if constexpr (dim != 2) {
             std::cerr << "Error: This constructor can only be used with dim = 2" << std::endl;
             std::exit(EXIT_FAILURE);
+        } else {
+            this->grid = grid;
         }
         VerifyWaveFields();
 
@@ -54,14 +103,15 @@ public:
         ScalarField* nodeDepth  = nodeList->getField<double>("depth");
         nodeDepth->copyValues(depth);
 
-        ScalarField* cs = nodeList->getField<double>("soundSpeed");
         double maxC = 0;
-        #pragma omp parallel for reduction(max:maxC)
-        for (int i=0; i<nodeList->getNumNodes();++i) {
-            double c = (depth->getValue(i) < 0 ? sqrt(C*std::abs(depth->getValue(i))) : 0);
-            cs->setValue(i,c);
-            maxC = std::max(c,maxC);
-        }
+        this->WithScalarField("soundSpeed", [&](auto* cs) {
+            #pragma omp parallel for reduction(max:maxC)
+            for (int i=0; i<nodeList->getNumNodes();++i) {
+                double c = (depth->getValue(i) < 0 ? sqrt(C*std::abs(depth->getValue(i))) : 0);
+                cs->setValue(i,c);
+                maxC = std::max(c,maxC);
+            }
+        });
         C = maxC;
 
         for (int i = 0; i < dim; ++i)
@@ -72,28 +122,208 @@ public:
 
     virtual void
     ZeroTimeInitialize() override {
-        int numNodes = this->nodeList->size();
-        for (int i=0; i<numNodes; ++i) {
-            if (ocean) {
-                if (!grid2d->onBoundary(i))
-                    insideIds.push_back(i);
+        BuildStencil();
+        BuildAbsorbingLayers();
+        this->UpdateState();
+        this->InitializeBoundaries();
+    }
+
+    void
+    BuildStencil() {
+        const int numNodes = this->nodeList->size();
+        ScalarField* depth = (ocean ? this->nodeList->template getField<double>("depth") : nullptr);
+        auto wet = [depth](int i) { return !depth || depth->getValue(i) < 0; };
+
+        insideIds.clear();
+        stencil.clear();
+        const std::array<int, 3> n = {grid->nx, grid->ny, grid->nz};
+        for (int i = 0; i < numNodes; ++i) {
+            if (grid->onBoundary(i) || !wet(i)) continue;
+            insideIds.push_back(i);
+            const std::array<int, 3> c = grid->indexToCoordinates(i);
+            int stride = 1;
+            for (int k = 0; k < dim; ++k) {
+                const int iL = (c[k] > 0 ? i - stride : i);
+                const int iR = (c[k] < n[k] - 1 ? i + stride : i);
+                stencil.push_back(wet(iL) ? iL : i);
+                stencil.push_back(wet(iR) ? iR : i);
+                stride *= n[k];
             }
-            else {
-                if (!grid->onBoundary(i))
-                    insideIds.push_back(i);
+        }
+
+        // chunks a good many strides long, so that few cells wait for the end of the sweep
+        maxStride = (dim == 1 ? 1 : (dim == 2 ? n[0] : n[0] * n[1]));
+        const int chunk = std::max(32 * maxStride, 4096);
+        chunkStart.clear();
+        for (int p = 0; p < (int)insideIds.size(); p += chunk) chunkStart.push_back(p);
+        chunkStart.push_back(insideIds.size());
+    }
+
+    // Gather the layer cells of every absorbing boundary (adding up sigma where layers
+    // overlap) and the cells next to them, whose divergence of psi reaches into the layer
+    void
+    BuildAbsorbingLayers() {
+        const int numNodes = this->nodeList->size();
+        std::vector<double> sigma(dim * numNodes, 0.0);
+        std::vector<char> inLayer(numNodes, 0);
+        for (Boundary<dim>* boundary : this->boundaries)
+            if (auto* layer = dynamic_cast<AbsorbingGridBoundary<dim>*>(boundary)) {
+                const std::vector<int>& ids = layer->getIds();
+                const std::vector<double>& profile = layer->getProfile();
+                for (int q = 0; q < (int)ids.size(); ++q) {
+                    inLayer[ids[q]] = 1;
+                    for (int k = 0; k < dim; ++k)
+                        sigma[dim * ids[q] + k] += profile[dim * q + k];
+                }
             }
+
+        layerIds.clear();
+        layerInside.clear();
+        layerProfile.clear();
+        layerOf.assign(insideIds.size(), -1);
+        std::vector<int> layerPos(numNodes, -1);
+        for (int p = 0; p < (int)insideIds.size(); ++p) {
+            const int i = insideIds[p];
+            bool near = inLayer[i];
+            for (int k = 0; k < 2 * dim && !near; ++k)
+                near = inLayer[stencil[2 * dim * p + k]];
+            if (!near) continue;
+            layerPos[i] = layerIds.size();
+            layerOf[p] = layerIds.size();
+            layerIds.push_back(i);
+            layerInside.push_back(p);
+            for (int k = 0; k < dim; ++k)
+                layerProfile.push_back(sigma[dim * i + k]);
         }
 
-        this->UpdateState();
-        this->InitializeBoundaries();
+        // a neighbor outside the list carries no psi
+        layerStencil.resize(2 * dim * layerIds.size());
+        for (int q = 0; q < (int)layerIds.size(); ++q) {
+            const int i = layerIds[q];
+            for (int k = 0; k < 2 * dim; ++k) {
+                const int j = stencil[2 * dim * layerInside[q] + k];
+                layerStencil[2 * dim * q + k] = (j == i ? -1 : layerPos[j]);
+            }
+        }
+        psi.assign(dim * layerIds.size(), 0.0);
+        Phi.assign(layerIds.size(), 0.0);
+        layerGrad.assign(dim * layerIds.size(), 0.0);
+        layerPhi.assign(layerIds.size(), 0.0);
+    }
+
+    // central differences of phi at the layer cells
+    void
+    LayerGradient(const ScalarField* phi, std::vector<double>& grad) const {
+        #pragma omp parallel for
+        for (int q = 0; q < layerIds.size(); ++q) {
+            const int* nbr = &stencil[2 * dim * layerInside[q]];
+            for (int k = 0; k < dim; ++k)
+                grad[dim * q + k] = (phi->getValue(nbr[2 * k + 1]) - phi->getValue(nbr[2 * k])) /
+                                    (2.0 * grid->spacing(k));
+        }
+    }
+
+    virtual void
+    FinalizeStep(const State<dim>* finalState) override {
+        Physics<dim>::FinalizeStep(finalState);
+        if (!layerIds.empty())
+            AdvanceLayers(this->stepDt);
+    }
+
+    // Advance psi (and Phi = int phi dt) over the step just taken, exactly for the decay
+    // and with the average of grad phi over the step as the source:
+    //   dpsi_k/dt = -sigma_k psi_k + c^2 ((S1 - 2 sigma_k) dphi/dx_k + (prod_{j!=k} sigma_j) dPhi/dx_k)
+    void
+    AdvanceLayers(const double dt) {
+        ScalarField* phi = this->nodeList->template getField<double>("phi");
+        std::vector<double> grad(dim * layerIds.size());
+        LayerGradient(phi, grad);
+        this->WithScalarField("soundSpeed", [&](auto* cs) {
+            const int numLayer = layerIds.size();
+            std::vector<double> PhiGrad(dim * numLayer, 0.0);
+            if constexpr (dim == 3) {
+                for (int q = 0; q < numLayer; ++q)
+                    for (int k = 0; k < dim; ++k) {
+                        const int qL = layerStencil[2 * dim * q + 2 * k], qR = layerStencil[2 * dim * q + 2 * k + 1];
+                        PhiGrad[dim * q + k] = ((qR < 0 ? Phi[q] : Phi[qR]) - (qL < 0 ? Phi[q] : Phi[qL])) /
+                                               (2.0 * grid->spacing(k));
+                    }
+            }
+            #pragma omp parallel for
+            for (int q = 0; q < numLayer; ++q) {
+                const double c = cs->getValue(layerIds[q]);
+                const double* sk = &layerProfile[dim * q];
+                double S1 = 0.0;
+                for (int k = 0; k < dim; ++k) S1 += c * sk[k];
+                for (int k = 0; k < dim; ++k) {
+                    const double sigma = c * sk[k];
+                    double others = 1.0;
+                    for (int j = 0; j < dim; ++j)
+                        if (j != k) others *= c * sk[j];
+                    const double source = c * c * ((S1 - 2.0 * sigma) * 0.5 * (layerGrad[dim * q + k] + grad[dim * q + k]) +
+                                                   (dim == 3 ? others * PhiGrad[dim * q + k] : 0.0));
+                    const double decay = std::exp(-sigma * dt);
+                    psi[dim * q + k] = decay * psi[dim * q + k] + (sigma > 0.0 ? (1.0 - decay) / sigma : dt) * source;
+                }
+                if (dim == 3)
+                    Phi[q] += 0.5 * dt * (layerPhi[q] + phi->getValue(layerIds[q]));
+            }
+        });
     }
 
     void
     VerifyWaveFields() {
-        this->template EnrollFields<double>({"phi", "xi", "maxphi", "phisq", "soundSpeed", "waveEnergyDensity"});
+        this->template EnrollFields<double>({"phi", "xi"});
+        this->template EnrollFields<double>({"maxphi", "phisq", "soundSpeed", "waveEnergyDensity"}, precision);
         this->template EnrollStateFields<double>({"phi", "xi"});
     }
 
+    virtual void
+    PreStepInitialize() override {
+        Physics<dim>::PreStepInitialize();
+        if (activeTracking)
+            UpdateActivity();
+        if (!layerIds.empty()) {
+            ScalarField* phi = this->nodeList->template getField<double>("phi");
+            LayerGradient(phi, layerGrad);
+            for (int q = 0; q < (int)layerIds.size(); ++q) layerPhi[q] = phi->getValue(layerIds[q]);
+        }
+    }
+
+    // Mark the blocks whose phi or xi changed over the last step, or that this package's
+    // own derivatives were changing. The Laplacian reaches one cell per stage, four stages
+    // (RK4) per step.
+    void
+    UpdateActivity() {
+        const int n = this->nodeList->size();
+        ScalarField* phi = this->nodeList->template getField<double>("phi");
+        ScalarField* xi  = this->nodeList->template getField<double>("xi");
+
+        const bool first = !activity;
+        if (first) {
+            activity = std::make_unique<Mesh::ActiveBlocks<dim>>(grid, activeBlockSize, 4);
+            lastPhi.resize(n);
+            lastXi.resize(n);
+            cellDt.assign(n, 1e30);
+            driven.assign(n, 0);
+        }
+        const double tol = activityTolerance;
+        activity->update([&](int i) {
+            const double phii = phi->getValue(i), xii = xi->getValue(i);
+            bool changed = first || driven[i] || std::abs(phii - lastPhi[i]) > tol || std::abs(xii - lastXi[i]) > tol;
+            lastPhi[i] = phii;
+            lastXi[i]  = xii;
+            driven[i]  = 0;
+            return changed;
+        });
+    }
+
+    // whether a change this package made over a step is beyond the activity tolerance
+    inline bool
+    Drives(const double change) const {
+        return change != 0.0 && std::abs(change) >= activityTolerance;
+    }
+
     virtual void
     EvaluateDerivatives(const State<dim>* initialState, State<dim>& deriv, const double time, const double dt) override {  
         int numNodes = this->nodeList->size();
@@ -104,36 +334,195 @@ public:
         ScalarField* DxiDt  = deriv.template getField<double>("xi");
         ScalarField* DphiDt = deriv.template getField<double>("phi");
 
-        ScalarField* cs     = this->nodeList->template getField<double>("soundSpeed");
-        ScalarField* e      = this->nodeList->template getField<double>("waveEnergyDensity");
+        this->WithScalarField("soundSpeed", [&](auto* cs) {
+            this->WithScalarField("waveEnergyDensity", [&](auto* e) {
+                EvaluateWave(xi, phi, DxiDt, DphiDt, cs, e, dt);
+            });
+        });
+    }
 
+    template <typename SoundSpeedField, typename EnergyField>
+    void
+    EvaluateWave(ScalarField* xi, ScalarField* phi, ScalarField* DxiDt, ScalarField* DphiDt,
+                 const SoundSpeedField* cs, EnergyField* e, const double dt) {
         double local_dtmin = 1e30;
+        double h[dim];
+        for (int k = 0; k < dim; ++k) h[k] = grid->spacing(k);
 
         #pragma omp parallel for reduction(min:local_dtmin)
         for (int p = 0; p < insideIds.size(); ++p) {
             int i = insideIds[p];
+            if (activity && !activity->isActive(i)) continue;
 
             double c        = cs->getValue(i);
             double xi_i     = xi->getValue(i);
-
-            double laplace  = grid->laplacian(i, phi);
-            auto grad       = grid->gradient(i, phi);
-            double grad2    = grad.mag2(); 
+            double phi_i    = phi->getValue(i);
+
+            const int* nbr  = &stencil[2 * dim * p];
+            double laplace  = 0.0;
+            double grad2    = 0.0;
+            for (int k = 0; k < dim; ++k) {
+                double phiL = phi->getValue(nbr[2 * k]);
+                double phiR = phi->getValue(nbr[2 * k + 1]);
+                double g    = (phiR - phiL) / (2.0 * h[k]);
+                laplace += (phiR - 2.0 * phi_i + phiL) / (h[k] * h[k]);
+                grad2   += g * g;
+            }
 
             DxiDt->setValue(i, laplace * c * c);
             DphiDt->setValue(i, dt * DxiDt->getValue(i) + xi_i);
             e->setValue(i, 0.5 * (xi_i * xi_i + c * c * grad2));
 
-            local_dtmin = std::min(local_dtmin, 0.2 * dxmin / c);
+            const double dti = 0.2 * dxmin / c;
+            local_dtmin = std::min(local_dtmin, dti);
+            if (activity) {
+                cellDt[i] = dti;
+                if (Drives(this->stepDt * DxiDt->getValue(i)) || Drives(this->stepDt * DphiDt->getValue(i))) driven[i] = 1;
+            }
+        }
+
+        // in the layers: xi_t = c^2 lap(phi) + div(psi) - S1 xi - S2 phi - S3 Phi
+        #pragma omp parallel for
+        for (int q = 0; q < layerIds.size(); ++q) {
+            const int i = layerIds[q];
+            if (activity && !activity->isActive(i)) continue;
+            double S1;
+            const double force = LayerForce(q, cs->getValue(i), phi->getValue(i), h, S1);
+            const double xi_i = xi->getValue(i);
+            const double DxiDt_i = DxiDt->getValue(i) + force - S1 * xi_i;
+            DxiDt->setValue(i, DxiDt_i);
+            DphiDt->setValue(i, dt * DxiDt_i + xi_i);
+            if (activity && (Drives(this->stepDt * DxiDt_i) || Drives(this->stepDt * DphiDt->getValue(i)))) driven[i] = 1;
+        }
+        if (activity) {
+            #pragma omp parallel for reduction(min:local_dtmin)
+            for (int p = 0; p < insideIds.size(); ++p)
+                local_dtmin = std::min(local_dtmin, cellDt[insideIds[p]]);
+        }
+        dtmin = local_dtmin;
+    }
+
+    // The layer terms of xi_t but for the damping -S1 xi: div(psi) - S2 phi - S3 Phi, with S1,
+    // S2 and S3 the sum, the sum of pairwise products and the product of the sigma_k (Grote & Sim 2010)
+    inline double
+    LayerForce(const int q, const double c, const double phi_i, const double* h, double& S1) const {
+        double sigma[3] = {0.0, 0.0, 0.0};
+        double divPsi = 0.0;
+        for (int k = 0; k < dim; ++k) {
+            sigma[k] = c * layerProfile[dim * q + k];
+            const int qL = layerStencil[2 * dim * q + 2 * k], qR = layerStencil[2 * dim * q + 2 * k + 1];
+            divPsi += ((qR < 0 ? 0.0 : psi[dim * qR + k]) - (qL < 0 ? 0.0 : psi[dim * qL + k])) / (2.0 * h[k]);
+        }
+        S1 = sigma[0] + sigma[1] + sigma[2];
+        const double S2 = sigma[0] * sigma[1] + sigma[1] * sigma[2] + sigma[0] * sigma[2];
+        const double S3 = sigma[0] * sigma[1] * sigma[2];
+        return divPsi - S2 * phi_i - S3 * Phi[q];
+    }
+
+    virtual void
+    Leapfrog(const double dt, const double kickDt) override {
+        this->WithScalarField("soundSpeed", [&](auto* cs) {
+            this->WithScalarField("waveEnergyDensity", [&](auto* e) {
+                LeapfrogSweep(cs, e, dt, kickDt);
+            });
+        });
+    }
+
+    // xi += kickDt xi_t(phi), then phi += dt xi, in place. In the layers the damping takes
+    // the mean of the old and new xi, which keeps the kick stable however large S1 dt gets.
+    template <typename SoundSpeedField, typename EnergyField>
+    void
+    LeapfrogSweep(const SoundSpeedField* cs, EnergyField* e, const double dt, const double kickDt) {
+        ScalarField* xi  = this->nodeList->template getField<double>("xi");
+        ScalarField* phi = this->nodeList->template getField<double>("phi");
+        double h[dim];
+        for (int k = 0; k < dim; ++k) h[k] = grid->spacing(k);
+
+        const int numChunks = chunkStart.size() - 1;
+        std::vector<int> head(numChunks), tail(numChunks);
+        auto drift = [&](int r) {
+            const int j = insideIds[r];
+            if (activity && !activity->isActive(j)) return;
+            (*phi)[j] += dt * xi->getValue(j);
+        };
+
+        double local_dtmin = 1e30;
+        #pragma omp parallel for schedule(dynamic, 1) reduction(min:local_dtmin)
+        for (int b = 0; b < numChunks; ++b) {
+            const int pa = chunkStart[b], pb = chunkStart[b + 1];
+            // the first chunk has no one before it to wait for, nor the last after it
+            int r = pa;
+            if (b > 0)
+                while (r < pb && insideIds[r] < insideIds[pa] + maxStride) ++r;
+            head[b] = r;
+
+            for (int p = pa; p < pb; ++p) {
+                const int i = insideIds[p];
+                if (!activity || activity->isActive(i)) {
+                    const double c     = cs->getValue(i);
+                    const double phi_i = phi->getValue(i);
+                    const int* nbr     = &stencil[2 * dim * p];
+                    double laplace = 0.0;
+                    double grad2   = 0.0;
+                    for (int k = 0; k < dim; ++k) {
+                        double phiL = phi->getValue(nbr[2 * k]);
+                        double phiR = phi->getValue(nbr[2 * k + 1]);
+                        double g    = (phiR - phiL) / (2.0 * h[k]);
+                        laplace += (phiR - 2.0 * phi_i + phiL) / (h[k] * h[k]);
+                        grad2   += g * g;
+                    }
+
+                    double xi_i = xi->getValue(i);
+                    const int q = (layerOf.empty() ? -1 : layerOf[p]);
+                    if (q < 0) {
+                        xi_i += kickDt * laplace * c * c;
+                    } else {
+                        double S1;
+                        const double force = laplace * c * c + LayerForce(q, c, phi_i, h, S1);
+                        xi_i = ((1.0 - 0.5 * S1 * kickDt) * xi_i + kickDt * force) / (1.0 + 0.5 * S1 * kickDt);
+                    }
+                    if (activity && (Drives(xi_i - xi->getValue(i)) || Drives(dt * xi_i))) driven[i] = 1;
+                    (*xi)[i] = xi_i;
+                    e->setValue(i, 0.5 * (xi_i * xi_i + c * c * grad2));
+
+                    const double dti = 0.2 * dxmin / c;
+                    local_dtmin = std::min(local_dtmin, dti);
+                    if (activity) cellDt[i] = dti;
+                }
+                for (; r < pb && insideIds[r] + maxStride <= i; ++r) drift(r);
+            }
+            if (b == numChunks - 1)
+                for (; r < pb; ++r) drift(r);
+            tail[b] = r;
+        }
+
+        #pragma omp parallel for
+        for (int b = 0; b < numChunks; ++b) {
+            for (int r = chunkStart[b]; r < head[b]; ++r) drift(r);
+            for (int r = tail[b]; r < chunkStart[b + 1]; ++r) drift(r);
+        }
+
+        if (activity) {
+            #pragma omp parallel for reduction(min:local_dtmin)
+            for (int p = 0; p < insideIds.size(); ++p)
+                local_dtmin = std::min(local_dtmin, cellDt[insideIds[p]]);
         }
         dtmin = local_dtmin;
     }
 
+    virtual void
+    FinalizeLeapfrog() override {
+        SecondOrderPhysics<dim>::FinalizeLeapfrog();
+        if (!layerIds.empty())
+            AdvanceLayers(this->stepDt);
+    }
+
     double
     getCell(int i,int j, std::string fieldName="phi") {
         int idx = (ocean ? grid2d->index(i,j,0) : grid->index(i,j,0));
-        ScalarField* phi    = this->nodeList->template getField<double>(fieldName);
-        return phi->getValue(idx);
+        double value;
+        this->WithScalarField(fieldName, [&](auto* field) { value = field->getValue(idx); });
+        return value;
     }
 
     virtual void
@@ -143,13 +532,16 @@ public:
         ScalarField* xi     = this->nodeList->template getField<double>("xi");
         ScalarField* phi    = this->nodeList->template getField<double>("phi");
 
-        ScalarField* mphi   = this->nodeList->template getField<double>("maxphi"); // diagnostic fields for plotting
-        ScalarField* phis   = this->nodeList->template getField<double>("phisq");  // diagnostic fields for plotting
-        
-        for (int i=0; i<numNodes; ++i) {
-            mphi->setValue(i,std::max(mphi->getValue(i),phi->getValue(i)*phi->getValue(i)));
-            phis->setValue(i,phi->getValue(i)*phi->getValue(i));
-        }
+        // diagnostic fields for plotting
+        this->WithScalarField("maxphi", [&](auto* mphi) {
+            this->WithScalarField("phisq", [&](auto* phis) {
+                for (int i=0; i<numNodes; ++i) {
+                    double phi2 = phi->getValue(i)*phi->getValue(i);
+                    mphi->setValue(i,std::max<double>(mphi->getValue(i),phi2));
+                    phis->setValue(i,phi2);
+                }
+            });
+        });
     }
 
     virtual double 
@@ -157,6 +549,18 @@ public:
         return dtmin;
     }
 
+    inline int getNumInsideCells() const { return insideIds.size(); }
+    inline int getNumLayerCells() const { return layerIds.size(); }
+    inline std::string getPrecision() const { return (precision == Precision::Single ? "single" : "double"); }
+    inline bool getActiveTracking() const { return activeTracking; }
+    inline void setActiveTracking(const bool value) { activeTracking = value; activity.reset(); }
+    inline double getActivityTolerance() const { return activityTolerance; }
+    inline void setActivityTolerance(const double value) { activityTolerance = value; }
+    inline int getActiveBlockSize() const { return activeBlockSize; }
+    inline void setActiveBlockSize(const int value) { activeBlockSize = std::max(value, 1); activity.reset(); }
+    inline double getActiveFraction() const {
+        return (activity ? (double)activity->numActiveBlocks() / activity->numBlocks() : 1.0); }
+
     virtual std::string name() const override { return "waveEquation"; }
     virtual std::string description() const override {
         return "Acoustic wave physics package for grids"; }
@@ -7,17 +7,26 @@ class WaveEquation(Physics):
                nodeList="NodeList*",
                constants="PhysicalConstants&",
                grid="Mesh::Grid<%(dim)s>*",
-               C="double"):
+               C="double",
+               precision=("std::string", '"double"')):
         return
     def pyinit1(self,
                nodeList="NodeList*",
                constants="PhysicalConstants&",
                grid="Mesh::Grid<2>*",
-               depthMap="std::string&"):
+               depthMap="std::string&",
+               precision=("std::string", '"double"')):
         return
     @PYB11cppname("getCell")
     def getCell2d(self,i="int",j="int",fieldName="std::string"):
         return
+    numInsideCells = PYB11property("int", getter="getNumInsideCells", doc="Cells evaluated each stage: the inside cells, less land in ocean mode.")
+    numLayerCells = PYB11property("int", getter="getNumLayerCells", doc="Inside cells damped by absorbing boundaries.")
+    precision = PYB11property("std::string", getter="getPrecision", doc="Storage of the diagnostic and sound speed fields, double or single.")
+    activeTracking = PYB11property("bool", getter="getActiveTracking", setter="setActiveTracking", doc="Only evaluate the blocks of cells near those that changed, or that this package was changing, over the last step.")
+    activityTolerance = PYB11property("double", getter="getActivityTolerance", setter="setActivityTolerance", doc="Change in phi or xi below which a cell counts as unchanged.")
+    activeBlockSize = PYB11property("int", getter="getActiveBlockSize", setter="setActiveBlockSize", doc="Cells per side of an activity block.")
+    activeFraction = PYB11property("double", getter="getActiveFraction", doc="Fraction of blocks evaluated this step.")
 
 WaveEquation1d = PYB11TemplateClass(WaveEquation,
                               template_parameters = ("1"),
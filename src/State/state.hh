@@ -41,6 +41,13 @@ public:
         fields.push_back(newField);
     }
 
+    // Holds on to fieldPtr instead of copying it, so whatever is done to the field through
+    // this State is done to the original, which has to outlive the State
+    template <typename T>
+    void shareField(Field<T>* fieldPtr) {
+        fields.push_back(std::shared_ptr<Field<T>>(fieldPtr, [](Field<T>*) {}));
+    }
+
     template <typename T>
     Field<T>* 
     getField(const std::string& name) const {
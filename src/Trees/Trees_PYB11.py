@@ -1,5 +1,7 @@
 from PYB11Generator import *
-PYB11includes = ['"kdTree.hh"','"spatialTree.hh"']
+PYB11includes = ['"kdTree.hh"','"spatialTree.hh"','"cellList.hh"','"neighborList.hh"']
 
 from kdTree import *
-from spatialTree import *
\ No newline at end of file
+from spatialTree import *
+from cellList import *
+from neighborList import *
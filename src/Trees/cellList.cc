@@ -0,0 +1,240 @@
+// Copyright (C) 2025  Cody Raskin
+
+#ifndef CELLLIST_CC
+#define CELLLIST_CC
+
+#include "cellList.hh"
+#include <algorithm>
+#include <stdexcept>
+
+template <int dim>
+CellList<dim>::CellList(Field<Lin::Vector<dim>>* points, double cellSize) :
+    points(points), cellSize(cellSize), periodic(false) {
+    if (cellSize <= 0.0)
+        throw std::invalid_argument("CellList: cellSize must be positive");
+    build();
+}
+
+template <int dim>
+CellList<dim>::CellList(Field<Lin::Vector<dim>>* points, double cellSize,
+                        const Lin::Vector<dim>& boxMin, const Lin::Vector<dim>& boxMax) :
+    points(points), cellSize(cellSize), periodic(true), boxMin(boxMin), boxMax(boxMax) {
+    if (cellSize <= 0.0)
+        throw std::invalid_argument("CellList: cellSize must be positive");
+    for (int d = 0; d < dim; ++d)
+        if (boxMax[d] <= boxMin[d])
+            throw std::invalid_argument("CellList: periodic box has zero extent");
+    build();
+}
+
+template <int dim>
+void
+CellList<dim>::build() {
+    const int N = points->size();
+
+    if (!periodic) {
+        for (int d = 0; d < dim; ++d) {
+            double lo = 1e300, hi = -1e300;
+            #pragma omp parallel for reduction(min:lo) reduction(max:hi)
+            for (int i = 0; i < N; ++i) {
+                double x = (*points)[i][d];
+                lo = std::min(lo, x);
+                hi = std::max(hi, x);
+            }
+            boxMin[d] = (N > 0 ? lo : 0.0);
+            boxMax[d] = (N > 0 ? hi : 0.0);
+        }
+    }
+    boxLength = boxMax - boxMin;
+
+    // a handful of far-flung points shouldn't make us allocate a huge empty grid,
+    // so coarsen the cells until there are at most ~2 per point
+    const long long maxCells = std::max(8LL, 2LL * N);
+    double width = cellSize;
+    while (true) {
+        long long total = 1;
+        for (int d = 0; d < dim; ++d) {
+            int n = (periodic ? (int)std::floor(boxLength[d] / width) : (int)std::floor(boxLength[d] / width) + 1);
+            ncells[d]    = std::max(1, n);
+            cellWidth[d] = (periodic ? boxLength[d] / ncells[d] : width);
+            total *= ncells[d];
+        }
+        if (total <= maxCells) break;
+        width *= 2.0;
+    }
+
+    int nc = 1;
+    for (int d = 0; d < dim; ++d) nc *= ncells[d];
+
+    cellOf.assign(N, 0);
+    cellStart.assign(nc + 1, 0);
+    sortedIds.assign(N, 0);
+
+    #pragma omp parallel for
+    for (int i = 0; i < N; ++i)
+        cellOf[i] = cellIndex(cellCoords((*points)[i]));
+
+    // counting sort: histogram, prefix sum, scatter
+    #pragma omp parallel for
+    for (int i = 0; i < N; ++i) {
+        #pragma omp atomic
+        cellStart[cellOf[i] + 1]++;
+    }
+
+    for (int c = 0; c < nc; ++c)
+        cellStart[c + 1] += cellStart[c];
+
+    std::vector<int> next(cellStart.begin(), cellStart.end() - 1);
+    #pragma omp parallel for
+    for (int i = 0; i < N; ++i) {
+        int slot;
+        #pragma omp atomic capture
+        slot = next[cellOf[i]]++;
+        sortedIds[slot] = i;
+    }
+
+    // the scatter order is thread dependent, so sort each cell to keep queries deterministic
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int c = 0; c < nc; ++c)
+        std::sort(sortedIds.begin() + cellStart[c], sortedIds.begin() + cellStart[c + 1]);
+}
+
+template <int dim>
+std::array<int, dim>
+CellList<dim>::cellCoords(const Vector& p) const {
+    std::array<int, dim> c;
+    for (int d = 0; d < dim; ++d) {
+        double x = p[d] - boxMin[d];
+        if (periodic)
+            x -= boxLength[d] * std::floor(x / boxLength[d]);
+        int ci = (int)std::floor(x / cellWidth[d]);
+        c[d] = std::min(std::max(ci, 0), ncells[d] - 1);
+    }
+    return c;
+}
+
+template <int dim>
+int
+CellList<dim>::cellIndex(const std::array<int, dim>& c) const {
+    int idx = 0;
+    for (int d = dim - 1; d >= 0; --d)
+        idx = idx * ncells[d] + c[d];
+    return idx;
+}
+
+template <int dim>
+template <typename Func>
+void
+CellList<dim>::forEachStencilCell(const std::array<int, dim>& c, double radius, Func&& f) const {
+    // per axis, the stencil is either a window [lo,hi] (wrapped if periodic) or the whole axis
+    std::array<int, dim> lo, len;
+    for (int d = 0; d < dim; ++d) {
+        int reach = (int)std::ceil(radius / cellWidth[d]);
+        if (periodic && 2 * reach + 1 >= ncells[d]) {
+            lo[d]  = 0;
+            len[d] = ncells[d];
+        } else if (periodic) {
+            lo[d]  = c[d] - reach;
+            len[d] = 2 * reach + 1;
+        } else {
+            lo[d]  = std::max(0, c[d] - reach);
+            len[d] = std::min(ncells[d] - 1, c[d] + reach) - lo[d] + 1;
+        }
+    }
+
+    std::array<int, dim> pos{}, s;
+    while (true) {
+        for (int d = 0; d < dim; ++d) {
+            s[d] = lo[d] + pos[d];
+            if (s[d] < 0) s[d] += ncells[d];
+            else if (s[d] >= ncells[d]) s[d] -= ncells[d];
+        }
+        f(cellIndex(s));
+        int d = 0;
+        while (d < dim && ++pos[d] == len[d]) { pos[d] = 0; ++d; }
+        if (d == dim) break;
+    }
+}
+
+template <int dim>
+Lin::Vector<dim>
+CellList<dim>::displacement(const Vector& a, const Vector& b) const {
+    Vector r = a - b;
+    if (periodic)
+        for (int d = 0; d < dim; ++d)
+            r[d] -= boxLength[d] * std::round(r[d] / boxLength[d]);
+    return r;
+}
+
+template <int dim>
+std::vector<int>
+CellList<dim>::findNeighbors(const Vector& point, double radius) const {
+    std::vector<int> result;
+    const double r2 = radius * radius;
+    forEachStencilCell(cellCoords(point), radius, [&](int c) {
+        for (int k = cellStart[c]; k < cellStart[c + 1]; ++k) {
+            int j = sortedIds[k];
+            const Vector& xj = (*points)[j];
+            // Exclude the identical point from the results
+            if (xj != point && displacement(point, xj).mag2() <= r2)
+                result.push_back(j);
+        }
+    });
+    return result;
+}
+
+template <int dim>
+std::vector<int>
+CellList<dim>::findNeighbors(int index, double radius) const {
+    std::vector<int> result;
+    forEachNeighbor(index, radius, [&result](int j, const Vector&) { result.push_back(j); });
+    return result;
+}
+
+template <int dim>
+template <typename Func>
+void
+CellList<dim>::forEachNeighbor(int index, double radius, Func&& f) const {
+    const double r2 = radius * radius;
+    const Vector& xi = (*points)[index];
+    forEachStencilCell(cellCoords(xi), radius, [&](int c) {
+        for (int k = cellStart[c]; k < cellStart[c + 1]; ++k) {
+            int j = sortedIds[k];
+            if (j == index) continue;
+            Vector rij = displacement(xi, (*points)[j]);
+            if (rij.mag2() <= r2)
+                f(j, rij);
+        }
+    });
+}
+
+template <int dim>
+template <typename Func>
+void
+CellList<dim>::forEachPair(double radius, Func&& f) const {
+    const double r2 = radius * radius;
+    const int nc = numCells();
+    std::array<int, dim> coords;
+    for (int c = 0; c < nc; ++c) {
+        if (cellStart[c] == cellStart[c + 1]) continue;
+        int rem = c;
+        for (int d = 0; d < dim; ++d) { coords[d] = rem % ncells[d]; rem /= ncells[d]; }
+
+        // half stencil: each unordered pair of cells is visited from the lower index
+        forEachStencilCell(coords, radius, [&](int c2) {
+            if (c2 < c) return;
+            for (int a = cellStart[c]; a < cellStart[c + 1]; ++a) {
+                int bstart = (c2 == c ? a + 1 : cellStart[c2]);
+                for (int b = bstart; b < cellStart[c2 + 1]; ++b) {
+                    int i = std::min(sortedIds[a], sortedIds[b]);
+                    int j = std::max(sortedIds[a], sortedIds[b]);
+                    Vector rij = displacement((*points)[i], (*points)[j]);
+                    if (rij.mag2() <= r2)
+                        f(i, j, rij);
+                }
+            }
+        });
+    }
+}
+
+#endif
@@ -0,0 +1,68 @@
+// Copyright (C) 2025  Cody Raskin
+
+#ifndef CELLLIST_HH
+#define CELLLIST_HH
+
+#include <vector>
+#include <array>
+#include <cmath>
+#include "../Math/vectorMath.hh"
+#include "../DataBase/field.hh"
+
+// Uniform cell-linked list for fixed-radius neighbor queries.
+// Points are binned into cells at least cellSize wide with a counting sort,
+// so a query at radius <= cellSize only has to look at the 3^dim stencil
+// around the point's own cell.
+template <int dim>
+class CellList {
+public:
+    using Vector = Lin::Vector<dim>;
+
+    CellList(Field<Lin::Vector<dim>>* points, double cellSize);
+    // periodic box [boxMin, boxMax)
+    CellList(Field<Lin::Vector<dim>>* points, double cellSize,
+             const Lin::Vector<dim>& boxMin, const Lin::Vector<dim>& boxMax);
+
+    void build();
+
+    std::vector<int> findNeighbors(const Vector& point, double radius) const;
+    std::vector<int> findNeighbors(int index, double radius) const;
+
+    // calls f(j, rij) for every j != index with |rij| <= radius, rij = x_index - x_j
+    template <typename Func>
+    void forEachNeighbor(int index, double radius, Func&& f) const;
+
+    // calls f(i, j, rij) once for every unordered pair with |rij| <= radius.
+    // the pair loop is serial so f is free to write to both i and j.
+    template <typename Func>
+    void forEachPair(double radius, Func&& f) const;
+
+    Vector displacement(const Vector& a, const Vector& b) const;
+
+    inline int numCells() const { return cellStart.size() - 1; }
+    inline double getCellSize() const { return cellSize; }
+    inline bool isPeriodic() const { return periodic; }
+
+private:
+    Field<Lin::Vector<dim>>* points;
+    double cellSize;
+    bool periodic;
+    Vector boxMin, boxMax, boxLength;
+    std::array<int, dim> ncells;
+    std::array<double, dim> cellWidth;
+
+    std::vector<int> cellOf;      // cell index of each point
+    std::vector<int> cellStart;   // CSR offsets into sortedIds, size numCells()+1
+    std::vector<int> sortedIds;   // point ids grouped by cell
+
+    std::array<int, dim> cellCoords(const Vector& p) const;
+    int cellIndex(const std::array<int, dim>& c) const;
+
+    // calls f(cell) once for every distinct cell within radius of cell c
+    template <typename Func>
+    void forEachStencilCell(const std::array<int, dim>& c, double radius, Func&& f) const;
+};
+
+#include "cellList.cc"
+
+#endif // CELLLIST_HH
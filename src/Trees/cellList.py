@@ -0,0 +1,49 @@
+from PYB11Generator import *
+
+@PYB11template("dim")
+class CellList:
+    def pyinit(self,
+               points="Field<Lin::Vector<%(dim)s>>*",
+               cellSize="double"):
+        return
+    def pyinit1(self,
+                points="Field<Lin::Vector<%(dim)s>>*",
+                cellSize="double",
+                boxMin="const Lin::Vector<%(dim)s>&",
+                boxMax="const Lin::Vector<%(dim)s>&"):
+        return
+    def build(self):
+        return
+    @PYB11pycppname("findNeighbors")
+    @PYB11const
+    def findNeighbors(self,
+                      point="const Lin::Vector<%(dim)s>&",
+                      radius="double"):
+        return "std::vector<int>"
+    @PYB11pycppname("findNeighbors")
+    @PYB11const
+    def findNeighbors1(self,
+                       index="int",
+                       radius="double"):
+        return "std::vector<int>"
+    def numCells(self):
+        return "int"
+
+    cellSize = PYB11property("double", getter="getCellSize", doc="Minimum cell width.")
+    periodic = PYB11property("bool", getter="isPeriodic", doc="Whether the cell list wraps periodically.")
+
+CellList1d = PYB11TemplateClass(CellList,
+                              template_parameters = ("1"),
+                              cppname = "CellList<1>",
+                              pyname = "CellList1d",
+                              docext = " (1D).")
+CellList2d = PYB11TemplateClass(CellList,
+                              template_parameters = ("2"),
+                              cppname = "CellList<2>",
+                              pyname = "CellList2d",
+                              docext = " (2D).")
+CellList3d = PYB11TemplateClass(CellList,
+                              template_parameters = ("3"),
+                              cppname = "CellList<3>",
+                              pyname = "CellList3d",
+                              docext = " (3D).")
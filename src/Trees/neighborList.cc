@@ -0,0 +1,82 @@
+// Copyright (C) 2025  Cody Raskin
+
+#ifndef NEIGHBORLIST_CC
+#define NEIGHBORLIST_CC
+
+#include "neighborList.hh"
+#include <stdexcept>
+#include <sstream>
+
+template <int dim>
+NeighborList<dim>::NeighborList(NodeList* nodeList, double radius, double skin) :
+    nodeList(nodeList), radius(radius), skin(skin) {
+    if (radius <= 0.0 || skin < 0.0)
+        throw std::invalid_argument("NeighborList: radius must be positive and skin non-negative");
+}
+
+template <int dim>
+std::shared_ptr<NeighborList<dim>>
+NeighborList<dim>::get(NodeList* nodeList, double radius, double skin) {
+    std::ostringstream key;
+    key << "NeighborList" << dim << std::hexfloat << " " << radius << " " << skin;
+    return nodeList->getShared<NeighborList<dim>>(key.str(), [&]() {
+        return std::make_shared<NeighborList<dim>>(nodeList, radius, skin); });
+}
+
+template <int dim>
+bool
+NeighborList<dim>::update(Field<Lin::Vector<dim>>* positions) {
+    const int N = positions->size();
+    if (builds == 0 || (int)x0.size() != N) {
+        build(positions);
+        return true;
+    }
+
+    double maxDisp2 = 0.0;
+    #pragma omp parallel for reduction(max:maxDisp2)
+    for (int i = 0; i < N; ++i)
+        maxDisp2 = std::max(maxDisp2, ((*positions)[i] - x0[i]).mag2());
+
+    // two nodes each moving skin/2 toward each other is the most the skin can absorb
+    if (4.0 * maxDisp2 > skin * skin) {
+        build(positions);
+        return true;
+    }
+    return false;
+}
+
+template <int dim>
+void
+NeighborList<dim>::build(Field<Lin::Vector<dim>>* positions) {
+    const int N = positions->size();
+    const double rlist = radius + skin;
+    CellList<dim> cells(positions, rlist);
+
+    offsets.assign(N + 1, 0);
+    #pragma omp parallel for
+    for (int i = 0; i < N; ++i) {
+        int count = 0;
+        cells.forEachNeighbor(i, rlist, [&count](int, const Vector&) { count++; });
+        offsets[i + 1] = count;
+    }
+    for (int i = 0; i < N; ++i)
+        offsets[i + 1] += offsets[i];
+
+    pairs.resize(offsets[N]);
+    #pragma omp parallel for
+    for (int i = 0; i < N; ++i) {
+        int k = offsets[i];
+        cells.forEachNeighbor(i, rlist, [&](int j, const Vector&) { pairs[k++] = j; });
+    }
+
+    x0.assign(positions->getValues().begin(), positions->getValues().end());
+    builds++;
+}
+
+template <int dim>
+std::vector<int>
+NeighborList<dim>::neighbors(int index) const {
+    return std::vector<int>(pairs.begin() + offsets[index], pairs.begin() + offsets[index + 1]);
+}
+
+#endif
@@ -0,0 +1,57 @@
+// Copyright (C) 2025  Cody Raskin
+
+#ifndef NEIGHBORLIST_HH
+#define NEIGHBORLIST_HH
+
+#include <vector>
+#include <memory>
+#include "cellList.hh"
+#include "../Math/vectorMath.hh"
+#include "../DataBase/nodeList.hh"
+
+// Verlet neighbor list cached across steps.
+// Pairs are stored in CSR form out to radius+skin and the list is only rebuilt
+// once some node has moved more than skin/2 since the last build, so callers
+// must still check |rij| <= radius on every pair they visit.
+template <int dim>
+class NeighborList {
+public:
+    using Vector = Lin::Vector<dim>;
+
+    NeighborList(NodeList* nodeList, double radius, double skin);
+
+    // shared instance for this NodeList, radius and skin, kept on the NodeList so that
+    // packages and Python modules asking for the same one get it; thread safe
+    static std::shared_ptr<NeighborList<dim>> get(NodeList* nodeList, double radius, double skin);
+
+    bool update(Field<Lin::Vector<dim>>* positions);
+    void build(Field<Lin::Vector<dim>>* positions);
+
+    std::vector<int> neighbors(int index) const;
+
+    // calls f(j) for every j in the (radius+skin) list of index
+    template <typename Func>
+    void forEachNeighbor(int index, Func&& f) const {
+        for (int k = offsets[index]; k < offsets[index + 1]; ++k)
+            f(pairs[k]);
+    }
+
+    inline NodeList* getNodeList() const { return nodeList; }
+    inline double getRadius() const { return radius; }
+    inline double getSkin() const { return skin; }
+    inline int numBuilds() const { return builds; }
+    inline int numPairs() const { return pairs.size(); }
+
+private:
+    NodeList* nodeList;
+    double radius, skin;
+    int builds = 0;
+
+    std::vector<Vector> x0;      // positions at the last build
+    std::vector<int> offsets;    // size N+1
+    std::vector<int> pairs;
+};
+
+#include "neighborList.cc"
+
+#endif // NEIGHBORLIST_HH
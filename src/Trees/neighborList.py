@@ -0,0 +1,49 @@
+from PYB11Generator import *
+
+@PYB11template("dim")
+@PYB11holder("std::shared_ptr")
+class NeighborList:
+    def pyinit(self,
+               nodeList="NodeList*",
+               radius="double",
+               skin="double"):
+        return
+    @PYB11static
+    def get(self,
+            nodeList="NodeList*",
+            radius="double",
+            skin="double"):
+        "The list shared by every caller with this nodeList, radius and skin"
+        return "std::shared_ptr<NeighborList<%(dim)s>>"
+    def update(self,
+               positions="Field<Lin::Vector<%(dim)s>>*"):
+        return "bool"
+    def build(self,
+              positions="Field<Lin::Vector<%(dim)s>>*"):
+        return
+    def neighbors(self,
+                  index="int"):
+        return "std::vector<int>"
+    def numBuilds(self):
+        return "int"
+    def numPairs(self):
+        return "int"
+
+    radius = PYB11property("double", getter="getRadius", doc="Interaction radius.")
+    skin = PYB11property("double", getter="getSkin", doc="Extra distance kept in the list between rebuilds.")
+
+NeighborList1d = PYB11TemplateClass(NeighborList,
+                              template_parameters = ("1"),
+                              cppname = "NeighborList<1>",
+                              pyname = "NeighborList1d",
+                              docext = " (1D).")
+NeighborList2d = PYB11TemplateClass(NeighborList,
+                              template_parameters = ("2"),
+                              cppname = "NeighborList<2>",
+                              pyname = "NeighborList2d",
+                              docext = " (2D).")
+NeighborList3d = PYB11TemplateClass(NeighborList,
+                              template_parameters = ("3"),
+                              cppname = "NeighborList<3>",
+                              pyname = "NeighborList3d",
+                              docext = " (3D).")
@@ -0,0 +1,50 @@
+from yggdrasil import *
+from Physics import WaveEquation2d
+from Mesh import Grid2d
+from Boundaries import DirichletGridBoundary2d, AbsorbingGridBoundary2d
+from math import exp
+
+# A pulse in a small box, with and without an absorbing layer around it, against the same
+# pulse in a box big enough that nothing comes back from its edges. The difference over
+# the inner region is what the edges of the small box reflected.
+
+commandLine = CommandLineArguments(inner = 120,
+                                   thickness = 20,
+                                   reflection = 1e-3,
+                                   order = 2,
+                                   tend = 200.0)
+
+constants = PhysicalConstants(1.0,1.0,1.0,1.0,1.0)
+
+def run(n, layer):
+    grid = Grid2d(n,n,1,1)
+    nodeList = NodeList(n*n)
+    wave = WaveEquation2d(nodeList,constants,grid,1.0)
+    box = DirichletGridBoundary2d(grid=grid)
+    wave.addBoundary(box)
+    if layer:
+        pml = AbsorbingGridBoundary2d(grid,thickness,reflection,order)
+        wave.addBoundary(pml)
+    phi = nodeList.getFieldDouble("phi")
+    for j in range(n):
+        for i in range(n):
+            r2 = (i - n//2)**2 + (j - n//2)**2
+            phi.setValue(grid.index(i,j,0), exp(-r2/8.0))
+    integrator = RungeKutta4Integrator2d([wave],dtmin=0.2)
+    o = n//2 - inner//2
+    history = []
+    while integrator.Time() < tend:
+        integrator.Step()
+        history.append([phi[grid.index(o+i,o+j,0)] for j in range(0,inner,4) for i in range(0,inner,4)])
+    return history
+
+reference = run(inner + 600, False)
+incident = max(abs(v) for step in reference for v in step)
+reflected = {}
+for label, history in [("dirichlet", run(inner + 40, False)), ("absorbing", run(inner + 2*thickness, True))]:
+    error = max(abs(a - b) for s1, s2 in zip(history, reference) for a, b in zip(s1, s2))
+    reflected[label] = error/incident
+    print("%s: largest reflected amplitude %.3e (%.2e of the largest in the region)" % (label, error, error/incident))
+assert reflected["absorbing"] < 1e-2, "the layer reflects more than a percent"
+assert reflected["absorbing"] < 0.1*reflected["dirichlet"], "the layer does little better than a bare wall"
+print("passed")
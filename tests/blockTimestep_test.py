@@ -0,0 +1,66 @@
+from yggdrasil import *
+from Physics import NBodyGravity3d
+import numpy as np
+
+# a loose cluster with one tight binary in the middle: the binary wants a step
+# hundreds of times shorter than everyone else, which is where block steps pay off
+commandLine = CommandLineArguments(numNodes = 200,
+                                   tstop = 0.5,
+                                   dtmin = 1e-6,
+                                   dtmax = 0.02,
+                                   tolerance = 1e-3)
+
+# unit mass chosen so that G = 1
+constants = PhysicalConstants(1.0,1.0/6.6743e-11,1.0,1.0,1.0)
+
+def setup():
+    nodeList = NodeList(numNodes)
+    gravity = NBodyGravity3d(nodeList=nodeList,constants=constants,plummerLength=0.0)
+    positions = nodeList.getFieldVector3d("position")
+    velocities = nodeList.getFieldVector3d("velocity")
+    mass = nodeList.getFieldDouble("mass")
+    rng = np.random.default_rng(3)
+    for i in range(numNodes):
+        x = rng.normal(size=3)
+        v = 0.3*rng.normal(size=3)
+        positions.setValue(i,Vector3d(x[0],x[1],x[2]))
+        velocities.setValue(i,Vector3d(v[0],v[1],v[2]))
+        mass.setValue(i,1.0/numNodes)
+    vc = 0.5*np.sqrt(0.1/0.01)
+    positions.setValue(0,Vector3d(0,0,0))
+    positions.setValue(1,Vector3d(0.01,0,0))
+    velocities.setValue(0,Vector3d(0,-vc,0))
+    velocities.setValue(1,Vector3d(0,vc,0))
+    mass.setValue(0,0.05)
+    mass.setValue(1,0.05)
+    return nodeList, gravity
+
+def energy(nodeList):
+    x = nodeList.getFieldVector3d("position")
+    v = nodeList.getFieldVector3d("velocity")
+    m = nodeList.getFieldDouble("mass")
+    e = 0
+    for i in range(numNodes):
+        e += 0.5*m[i]*v[i].mag2
+        for j in range(i+1,numNodes):
+            e -= m[i]*m[j]/(x[i]-x[j]).magnitude
+    return e
+
+nodeList, gravity = setup()
+integrator = BlockTimestepIntegrator3d([gravity],dtmin=dtmin,dtmax=dtmax)
+e0 = energy(nodeList)
+evaluations = 0
+substeps = 0
+while integrator.time < tstop:
+    integrator.Step()
+    evaluations += integrator.forceEvaluations
+    substeps += integrator.substeps
+
+error = (energy(nodeList)-e0)/abs(e0)
+print("force evaluations:",evaluations)
+print("with one global step:",substeps*numNodes)
+print("relative energy error:",error)
+assert abs(error) < tolerance, "energy error too large"
+# only the binary and its close neighbors should sit on the finest levels
+assert evaluations < 0.1*substeps*numNodes, "block steps evaluated nearly every node on every substep"
+print("passed")
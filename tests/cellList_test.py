@@ -0,0 +1,37 @@
+from yggdrasil import *
+from Trees import KDTree2d, CellList2d
+from RandomNodeGenerator import RandomNodeGenerator2d
+
+commandLine = CommandLineArguments(numNodes = 2000,
+                                   radius = 0.05)
+
+bounds = [[0,0],[1,1]]
+Generator = RandomNodeGenerator2d(numNodes=numNodes,bounds=bounds)
+nodeList = NodeList(numNodes)
+nodeList.insertFieldVector2d("position")
+positions = nodeList.getFieldVector2d("position")
+for i in range(numNodes):
+    positions.setValue(i,Vector2d(Generator.positions[i][0],Generator.positions[i][1]))
+
+tree = KDTree2d(positions)
+cells = CellList2d(positions,radius)
+print("cells:",cells.numCells())
+
+mismatches = 0
+for i in range(numNodes):
+    a = sorted(tree.findNearestNeighbors(positions[i],radius))
+    b = sorted(cells.findNeighbors(i,radius))
+    if a != b:
+        mismatches += 1
+print("mismatches against KDTree:",mismatches)
+assert mismatches == 0, "CellList and KDTree disagree"
+
+# periodic wrapping picks up neighbors across the box edge
+periodicCells = CellList2d(positions,radius,Vector2d(0,0),Vector2d(1,1))
+corner = Vector2d(0.001,0.001)
+openCount = len(cells.findNeighbors(corner,radius))
+periodicCount = len(periodicCells.findNeighbors(corner,radius))
+print("open neighbors of corner:",openCount)
+print("periodic neighbors of corner:",periodicCount)
+assert periodicCount > openCount, "periodic wrapping found nothing across the box edge"
+print("passed")
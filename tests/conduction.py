@@ -12,6 +12,8 @@ if __name__ == "__main__":
                                         dx = 1,
                                         dy = 1,
                                         dtmin = 0.001,
+                                        method = "explicit",
+                                        superStages = 0,
                                         intVerbose = True)
 
     myGrid = Grid2d(nx,ny,dx,dy)
@@ -26,12 +28,17 @@ if __name__ == "__main__":
     print(eos,"gamma =",eos.gamma)
     opac = ConstantOpacity(0.15,constants)
 
-    cond = ThermalConduction2d(myNodeList,constants,eos,opac,myGrid)
+    # method = "backwardEuler" or "crankNicolson" lifts the dx^2 timestep limit
+    cond = ThermalConduction2d(myNodeList,constants,eos,opac,myGrid,method)
 
     box = ReflectingGridBoundary2d(grid=myGrid)
     cond.addBoundary(box)
 
-    integrator = RungeKutta4Integrator2d([cond],dtmin=dtmin,verbose=intVerbose)
+    if superStages > 0:
+        # RKL2 super-time-stepping: explicit, but stable out to ~superStages^2/4 explicit steps
+        integrator = RungeKuttaLegendreIntegrator2d([cond],dtmin,superStages,2,intVerbose)
+    else:
+        integrator = RungeKutta4Integrator2d([cond],dtmin=dtmin,verbose=intVerbose)
 
     density = myNodeList.getFieldDouble("density")
     energy  = myNodeList.getFieldDouble("specificInternalEnergy")
@@ -13,7 +13,10 @@ if __name__ == "__main__":
                                        maxrho = 1e6,
                                        minT   = 200,
                                        maxT   = 1e8,
-                                       eos = "IdealGasEOS")
+                                       eos = "IdealGasEOS",
+                                       interpolation = "bilinear",
+                                       tabulate = False,
+                                       ntab = 64)
 
     assert eos in ["IdealGasEOS",
                    "HelmholtzEOS",
@@ -37,6 +40,7 @@ if __name__ == "__main__":
         eos = IdealGasEOS(1.4, constants)
     elif eos == "HelmholtzEOS":
         eos = HelmholtzEOS("genHelm.dat",constants)
+        eos.interpolation = interpolation
     elif eos == "MieGruneisenEOS":
         params = MieGruneisenMaterial("granite")  # still in CGS
         eos  = MieGruneisenEOS(constants=constants, **params) # granite params
@@ -50,6 +54,13 @@ if __name__ == "__main__":
     else:
         raise ValueError("EOS not implemented")
 
+    if tabulate:
+        model = eos
+        eos = TabulatedEOS(model, constants,
+                           np.log10(minrho), np.log10(maxrho), ntab,
+                           np.log10(minu), np.log10(maxu), ntab)
+        print("tabulation error: pressure %g, sound speed %g" % (eos.pressureError, eos.soundSpeedError))
+
     print(eos)
     print(type(eos))
 
@@ -0,0 +1,89 @@
+from yggdrasil import *
+from Physics import FEMHeatConduction2d
+from Mesh import FEMesh2d
+from math import sin, cos, sqrt
+
+# FEMHeatConduction applies the stiffness matrix and lumped mass it assembled once. One
+# forward Euler step on example.obj should give the same dT/dt as building and scattering
+# every element's matrices, which is done here element by element in plain Python.
+
+commandLine = CommandLineArguments(dt = 1e-6,
+                                   tolerance = 1e-8)
+
+g = 1.0/sqrt(3.0)
+gaussPoints = [(-g,-g), (g,-g), (g,g), (-g,g)]
+
+def shapeDerivatives(xi, eta):
+    return [(-0.25*(1 - eta), -0.25*(1 - xi)),
+            ( 0.25*(1 - eta), -0.25*(1 + xi)),
+            ( 0.25*(1 + eta),  0.25*(1 + xi)),
+            (-0.25*(1 + eta),  0.25*(1 - xi))]
+
+def shapeFunctions(xi, eta):
+    return [0.25*(1 - xi)*(1 - eta), 0.25*(1 + xi)*(1 - eta),
+            0.25*(1 + xi)*(1 + eta), 0.25*(1 - xi)*(1 + eta)]
+
+def triangleMatrices(x):
+    (x1,y1), (x2,y2), (x3,y3) = x
+    area = 0.5*abs((x2 - x1)*(y3 - y1) - (x3 - x1)*(y2 - y1))
+    b = [(y2 - y3)/(2*area), (y3 - y1)/(2*area), (y1 - y2)/(2*area)]
+    c = [(x3 - x2)/(2*area), (x1 - x3)/(2*area), (x2 - x1)/(2*area)]
+    K = [[area*(b[a]*b[d] + c[a]*c[d]) for d in range(3)] for a in range(3)]
+    return K, [area/3.0]*3
+
+def quadMatrices(x):
+    K = [[0.0]*4 for a in range(4)]
+    M = [0.0]*4
+    for xi, eta in gaussPoints:
+        dN = shapeDerivatives(xi, eta)
+        J00 = sum(dN[a][0]*x[a][0] for a in range(4))
+        J01 = sum(dN[a][0]*x[a][1] for a in range(4))
+        J10 = sum(dN[a][1]*x[a][0] for a in range(4))
+        J11 = sum(dN[a][1]*x[a][1] for a in range(4))
+        detJ = J00*J11 - J01*J10
+        grad = [(( J11*dN[a][0] - J01*dN[a][1])/detJ,
+                 (-J10*dN[a][0] + J00*dN[a][1])/detJ) for a in range(4)]
+        for a in range(4):
+            for d in range(4):
+                K[a][d] += (grad[a][0]*grad[d][0] + grad[a][1]*grad[d][1])*detJ
+        N = shapeFunctions(xi, eta)
+        for a in range(4):
+            M[a] += N[a]*detJ
+    return K, M
+
+mesh = FEMesh2d()
+mesh.buildFromObj("example.obj",axes="(x,z)")
+nodes = [(p.x, p.y) for p in mesh.getNodes()]
+n = len(nodes)
+
+constants = PhysicalConstants(1.0,1.0,1.0,1.0,1.0)
+nodeList = NodeList(n)
+conduction = FEMHeatConduction2d(nodeList,constants,mesh)
+print("%d nodes, %d stiffness entries" % (n, conduction.numNonZeros))
+
+temperature = nodeList.getFieldDouble("temperature")
+T0 = [1.0 + sin(3.0*x)*cos(2.0*y) for x, y in nodes]
+for i in range(n):
+    temperature.setValue(i,T0[i])
+
+# the per-element loop
+KT = [0.0]*n
+mass = [0.0]*n
+for conn in mesh.getElementConnectivity():
+    x = [nodes[a] for a in conn]
+    K, M = (triangleMatrices(x) if len(conn) == 3 else quadMatrices(x))
+    for a in range(len(conn)):
+        KT[conn[a]] += sum(K[a][d]*T0[conn[d]] for d in range(len(conn)))
+        mass[conn[a]] += M[a]
+expected = [(-KT[i]/mass[i] if mass[i] > 0.0 else 0.0) for i in range(n)]
+
+integrator = Integrator2d([conduction],dtmin=dt)
+integrator.Step()
+step = integrator.Time()
+measured = [(temperature[i] - T0[i])/step for i in range(n)]
+
+scale = max(abs(e) for e in expected)
+error = max(abs(a - b) for a, b in zip(measured, expected))/scale
+print("largest dT/dt %.3e, largest difference from the per-element loop %.3e (relative)" % (scale, error))
+assert error < tolerance, "assembled operators disagree with the per-element loop"
+print("passed")
@@ -0,0 +1,48 @@
+from yggdrasil import *
+from random import random, seed
+from math import sqrt, ceil
+from Physics import EventDrivenKinetics2d
+
+# A million hard spheres in a periodic unit box, set up with one bulk call per field.
+# Collisions are elastic, so the kinetic energy has to come back to roundoff.
+if __name__ == "__main__":
+    commandLine = CommandLineArguments(numNodes = 1000000,
+                                       packingFraction = 0.3,
+                                       cycles = 20,
+                                       tolerance = 1e-10)
+    seed(1)
+    constants = MKS()
+    myNodeList = NodeList(numNodes)
+
+    # hard-sphere gas in a periodic unit box
+    boxMin = Vector2d(0, 0)
+    boxMax = Vector2d(1, 1)
+    radius = sqrt(packingFraction/(numNodes*3.14159))
+
+    kinetics = EventDrivenKinetics2d(myNodeList, constants, Vector2d(0, 0), boxMin, boxMax)
+    integrator = Integrator2d(packages=[kinetics], dtmin=1e-6, verbose=False)
+
+    rad = myNodeList.getFieldDouble("radius")
+    mass = myNodeList.getFieldDouble("mass")
+    vel = myNodeList.getFieldVector2d("velocity")
+    rad.setValues([radius]*numNodes)
+    mass.setValues([1.0]*numNodes)
+    myNodeList.updateVelocities2d([[random()-0.5, random()-0.5] for i in range(numNodes)])
+
+    side = int(ceil(sqrt(numNodes)))
+    myNodeList.updatePositions2d([[(i%side+0.5)/side, (i//side+0.5)/side] for i in range(numNodes)])
+
+    def energy():
+        return sum(0.5*m*v.mag2 for m, v in zip(mass.values, vel.values))
+
+    e0 = energy()
+    controller = Controller(integrator=integrator, periodicWork=[], statStep=1)
+    events = 0
+    for c in range(cycles):
+        controller.Step()
+        events += kinetics.numEvents
+    error = (energy()-e0)/e0
+    print("collisions:", events)
+    print("relative energy error:", error)
+    assert abs(error) < tolerance, "elastic collisions did not conserve energy"
+    print("passed")
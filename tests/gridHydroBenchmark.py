@@ -0,0 +1,71 @@
+from yggdrasil import *
+import Physics
+from Mesh import Grid2d
+from EOS import IdealGasEOS
+from Boundaries import ReflectingGridBoundary2d
+import time
+
+# Throughput of every GridHydro Riemann solver / reconstruction pair on a Sod tube,
+# with the L1 density error against the exact solution at the end time
+
+commandLine = CommandLineArguments(nx = 400,
+                                   ny = 4,
+                                   endTime = 80.0,
+                                   dtmin = 0.001)
+
+solvers = ["HLLE", "HLLC", "Rusanov", "Exact"]
+reconstructions = ["PiecewiseConstant", "MUSCLMinmod", "MUSCLVanLeer", "MUSCLMC", "PPM"]
+
+constants = PhysicalConstants(1.0,1.0,1.0,1.0,1.0)
+eos = IdealGasEOS(1.4,constants)
+
+def exactDensity(xi):
+    # standard Sod (gamma = 1.4) star states and wave speeds
+    gamma, cL = 1.4, 1.4**0.5
+    pStar, vStar, rhoStarL, rhoStarR, shock = 0.30313, 0.92745, 0.42632, 0.26557, 1.75216
+    tail = vStar - cL*pStar**((gamma-1)/(2*gamma))
+    if xi < -cL:
+        return 1.0
+    if xi < tail:
+        c = 2/(gamma+1)*cL - (gamma-1)/(gamma+1)*xi
+        return (c/cL)**(2/(gamma-1))
+    if xi < vStar:
+        return rhoStarL
+    if xi < shock:
+        return rhoStarR
+    return 0.125
+
+def run(solver,reconstruction):
+    hydroClass = getattr(Physics,"GridHydro%s%s2d" % (solver,reconstruction))
+    myGrid = Grid2d(nx,ny,1,1)
+    myNodeList = NodeList(nx*ny)
+    hydro = hydroClass(myNodeList,constants,eos,myGrid)
+    box = ReflectingGridBoundary2d(grid=myGrid)
+    hydro.addBoundary(box)
+    integrator = RungeKutta4Integrator2d([hydro],dtmin=dtmin)
+
+    density = myNodeList.getFieldDouble("density")
+    energy  = myNodeList.getFieldDouble("specificInternalEnergy")
+    for j in range(ny):
+        for i in range(nx):
+            idx = myGrid.index(i,j,0)
+            density.setValue(idx, 1.0 if i < nx // 2 else 0.125)
+            energy.setValue(idx, 2.5 if i < nx // 2 else 2.0)
+
+    steps = 0
+    start = time.time()
+    while integrator.time < endTime:
+        integrator.Step()
+        steps += 1
+    elapsed = time.time() - start
+
+    error = 0.0
+    for i in range(2,nx-2):
+        xi = (i + 0.5 - nx/2)/integrator.time
+        error += abs(density[myGrid.index(i,ny//2,0)] - exactDensity(xi))
+    error /= (nx-4)
+    print("%-8s %-18s %6d steps %8.3f Mcell-steps/s  L1 %.4f" % (solver,reconstruction,steps,steps*nx*ny/elapsed/1e6,error))
+
+for solver in solvers:
+    for reconstruction in reconstructions:
+        run(solver,reconstruction)
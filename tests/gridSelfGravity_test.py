@@ -0,0 +1,45 @@
+from yggdrasil import *
+from Physics import GridSelfGravity3d
+from Mesh import Grid3d
+
+# a uniform sphere in the middle of an isolated grid: outside it the multigrid
+# acceleration should be G M / r^2 and inside G M r / R^3
+commandLine = CommandLineArguments(nx = 64,
+                                   radius = 0.2,
+                                   boundary = "isolated")
+
+# unit mass chosen so that G = 1
+constants = PhysicalConstants(1.0,1.0/6.6743e-11,1.0,1.0,1.0)
+
+grid = Grid3d(nx,nx,nx,1.0/nx,1.0/nx,1.0/nx)
+nodeList = NodeList(nx*nx*nx)
+gravity = GridSelfGravity3d(nodeList,constants,grid,boundary)
+
+center = Vector3d(0.5,0.5,0.5)
+density = nodeList.getFieldDouble("density")
+totalMass = 0.0
+for i in range(nx*nx*nx):
+    if (grid.getPosition(i)-center).magnitude < radius:
+        density.setValue(i,1.0)
+        totalMass += 1.0/nx**3
+
+integrator = Integrator3d([gravity],dtmin=1e-8)
+integrator.Step()
+coldCycles = gravity.lastCycles
+print("cycles from a cold start: %d"%coldCycles)
+integrator.Step()
+warmCycles = gravity.lastCycles
+print("cycles from a warm start: %d"%warmCycles)
+assert warmCycles < coldCycles, "starting from the last potential saved no cycles"
+
+acceleration = nodeList.getFieldVector3d("acceleration")
+for i in range(nx//2,nx):
+    idx = grid.index(i,nx//2,nx//2)
+    r = (grid.getPosition(idx)-center).magnitude
+    expected = (totalMass/r**2 if r > radius else totalMass*r/radius**3)
+    ratio = acceleration[idx].magnitude/expected
+    print("r = %.3f  |a| / analytic = %.4f"%(r,ratio))
+    # the staircase surface only blurs the profile within a couple of cells of r = radius
+    if abs(r - radius) > 2.0/nx:
+        assert abs(ratio - 1) < 0.03, "acceleration is off the analytic profile at r = %.3f" % r
+print("passed")
@@ -0,0 +1,77 @@
+from yggdrasil import *
+from random import random, seed
+from math import sqrt, ceil
+from Physics import EventDrivenKinetics2d
+
+# No two spheres should overlap after a step, however long it is. First a light sphere
+# kicked by a heavy one to nearly twice the fastest starting speed, into a particle it
+# was too far from to be grouped with at the start of the step; then a dense periodic gas
+# of heavy fast and light slow spheres, checked pair by pair after every step.
+commandLine = CommandLineArguments(numNodes = 400,
+                                   packingFraction = 0.4,
+                                   cycles = 10,
+                                   dt = 0.05)
+seed(2)
+constants = PhysicalConstants(1.0,1.0,1.0,1.0,1.0)
+
+def overlaps(nodeList, n, box):
+    pos = nodeList.getFieldVector2d("position")
+    rad = nodeList.getFieldDouble("radius")
+    worst = 0.0
+    count = 0
+    for i in range(n):
+        for j in range(i+1, n):
+            dx = pos[i].x - pos[j].x
+            dy = pos[i].y - pos[j].y
+            if box:
+                dx -= round(dx)
+                dy -= round(dy)
+            depth = rad[i] + rad[j] - sqrt(dx*dx + dy*dy)
+            if depth > 1e-9*rad[i]:
+                count += 1
+                worst = max(worst, depth/rad[i])
+    return count, worst
+
+# heavy -> light -> oncoming
+nodeList = NodeList(3)
+kinetics = EventDrivenKinetics2d(nodeList, constants, Vector2d(0, 0))
+integrator = Integrator2d(packages=[kinetics], dtmin=1.0, verbose=False)
+rad = nodeList.getFieldDouble("radius")
+mass = nodeList.getFieldDouble("mass")
+vel = nodeList.getFieldVector2d("velocity")
+for i, (m, v) in enumerate([(1000.0, 1.0), (1.0, 0.0), (1.0, -1.0)]):
+    rad.setValue(i, 0.1)
+    mass.setValue(i, m)
+    vel.setValue(i, Vector2d(v, 0))
+nodeList.updatePositions2d([[0.0, 0.0], [0.21, 0.0], [2.91, 0.0]])
+integrator.Step()
+count, worst = overlaps(nodeList, 3, False)
+print("three spheres: %d collisions, %d overlapping pairs" % (kinetics.numEvents, count))
+assert count == 0, "the kicked sphere ran into a particle outside its cluster"
+
+# dense gas
+nodeList = NodeList(numNodes)
+kinetics = EventDrivenKinetics2d(nodeList, constants, Vector2d(0, 0), Vector2d(0, 0), Vector2d(1, 1))
+integrator = Integrator2d(packages=[kinetics], dtmin=dt, verbose=False)
+radius = sqrt(packingFraction/(numNodes*3.14159))
+rad = nodeList.getFieldDouble("radius")
+mass = nodeList.getFieldDouble("mass")
+vel = nodeList.getFieldVector2d("velocity")
+for i in range(numNodes):
+    heavy = (i % 10 == 0)
+    rad.setValue(i, radius)
+    mass.setValue(i, 100.0 if heavy else 1.0)
+    scale = 1.0 if heavy else 0.05
+    vel.setValue(i, Vector2d(scale*(random()-0.5), scale*(random()-0.5)))
+side = int(ceil(sqrt(numNodes)))
+nodeList.updatePositions2d([[(i%side+0.5)/side, (i//side+0.5)/side] for i in range(numNodes)])
+
+total = 0
+for c in range(cycles):
+    integrator.Step()
+    count, worst = overlaps(nodeList, numNodes, True)
+    total += count
+    print("step %d: %d collisions, %d overlapping pairs (deepest %.2e radii)" % (c, kinetics.numEvents, count, worst))
+print("overlapping pairs over all steps:", total)
+assert total == 0, "spheres overlap after a step"
+print("passed")
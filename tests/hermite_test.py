@@ -0,0 +1,46 @@
+from yggdrasil import *
+from Physics import NBodyGravity2d
+from math import sqrt, pi, log
+
+# an e = 0.5 Kepler orbit followed for ten periods; the energy error should drop
+# by roughly 2^4 every time the number of steps doubles
+commandLine = CommandLineArguments(orbits = 10)
+
+# unit mass chosen so that G = 1
+constants = PhysicalConstants(1.0,1.0/6.6743e-11,1.0,1.0,1.0)
+
+def energy(nodeList):
+    x = nodeList.getFieldVector2d("position")
+    v = nodeList.getFieldVector2d("velocity")
+    return 0.25*(v[0].mag2 + v[1].mag2) - 0.25/(x[0]-x[1]).magnitude
+
+results = []
+for eta in [0.02,0.005,0.00125]:
+    nodeList = NodeList(2)
+    gravity = NBodyGravity2d(nodeList=nodeList,constants=constants,plummerLength=0.0)
+    positions = nodeList.getFieldVector2d("position")
+    velocities = nodeList.getFieldVector2d("velocity")
+    mass = nodeList.getFieldDouble("mass")
+    va = sqrt(0.5/1.5)
+    for i,sign in enumerate([-1,1]):
+        mass.setValue(i,0.5)
+        positions.setValue(i,Vector2d(0.75*sign,0))
+        velocities.setValue(i,Vector2d(0,0.5*va*sign))
+
+    integrator = HermiteIntegrator2d([gravity],dtmin=1e-3)
+    integrator.eta = eta
+    e0 = energy(nodeList)
+    steps = 0
+    while integrator.time < orbits*2*pi:
+        integrator.Step()
+        steps += 1
+    error = (energy(nodeList)-e0)/abs(e0)
+    print("eta:",eta,"steps:",steps,"relative energy error:",error)
+    assert abs(error) < 1e-3, "energy error too large at eta = %g" % eta
+    results.append((steps, abs(error)))
+
+for (steps1, error1), (steps2, error2) in zip(results[:-1], results[1:]):
+    order = log(error1/error2)/log(steps2/steps1)
+    print("convergence order: %.2f" % order)
+    assert order > 3.5, "Hermite is not converging at fourth order"
+print("passed")
@@ -0,0 +1,52 @@
+from yggdrasil import *
+from Physics import WaveEquation2d
+from Mesh import Grid2d
+from Boundaries import DirichletGridBoundary2d
+from math import exp
+import time
+
+# The same pulse in a closed box stepped with RungeKutta4 and with the in-place leapfrog.
+# The leapfrog should hold on to the wave energy at least as well, at a fraction of the
+# wall time per step.
+
+commandLine = CommandLineArguments(n = 300,
+                                   tend = 400.0)
+
+constants = PhysicalConstants(1.0,1.0,1.0,1.0,1.0)
+
+def run(integratorType):
+    grid = Grid2d(n,n,1,1)
+    nodeList = NodeList(n*n)
+    wave = WaveEquation2d(nodeList,constants,grid,1.0)
+    box = DirichletGridBoundary2d(grid=grid)
+    wave.addBoundary(box)
+    phi = nodeList.getFieldDouble("phi")
+    energy = nodeList.getFieldDouble("waveEnergyDensity")
+    for j in range(n):
+        for i in range(n):
+            r2 = (i - n//2)**2 + (j - n//2)**2
+            phi.setValue(grid.index(i,j,0), exp(-r2/8.0))
+    integrator = integratorType([wave],dtmin=0.2)
+    integrator.Step()
+    e0 = sum(energy[i] for i in range(n*n))
+    start = time.perf_counter()
+    while integrator.Time() < tend:
+        integrator.Step()
+    elapsed = time.perf_counter() - start
+    e1 = sum(energy[i] for i in range(n*n))
+    return [phi[i] for i in range(n*n)], elapsed, integrator.Cycle(), (e1 - e0)/e0
+
+results = {}
+for label, integratorType in [("rk4", RungeKutta4Integrator2d), ("leapfrog", LeapfrogIntegrator2d)]:
+    phi, elapsed, cycles, drift = results[label] = run(integratorType)
+    print("%s: %d steps in %.3fs (%.3e s/step), relative energy change %.3e" % (label, cycles, elapsed, elapsed/cycles, drift))
+
+error = max(abs(a - b) for a, b in zip(results["rk4"][0], results["leapfrog"][0]))
+print("largest difference between the two: %.3e" % error)
+drift = {label: results[label][3] for label in results}
+assert abs(drift["leapfrog"]) <= abs(drift["rk4"]), "leapfrog lost more wave energy than RK4"
+assert abs(drift["leapfrog"]) < 0.1, "leapfrog wave energy drifted by more than 10%"
+# RK4 damps the shortest wavelengths of the pulse, so the two part by a few percent of its
+# starting height; anything near the height itself means one of them went wrong
+assert error < 0.1, "RK4 and leapfrog disagree on the wave"
+print("passed")
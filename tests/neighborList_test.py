@@ -0,0 +1,81 @@
+from yggdrasil import *
+from Trees import NeighborList2d
+from Physics import PhaseCoupling2d
+from RandomNodeGenerator import RandomNodeGenerator2d
+import random
+from math import cos, sin
+
+# The cached Verlet list, filtered to |rij| <= radius, should give exactly the brute-force
+# pairs, both right after a build and after the nodes drift less than half the skin and
+# the list is reused. Lists shared through get are keyed on the skin as well as the radius,
+# and are kept on the NodeList, so this module sees the one PhaseCoupling built in Physics.
+
+commandLine = CommandLineArguments(numNodes = 1500,
+                                   radius = 0.05,
+                                   skin = 0.01,
+                                   seed = 4)
+
+random.seed(seed)
+bounds = [[0,0],[1,1]]
+Generator = RandomNodeGenerator2d(numNodes=numNodes,bounds=bounds)
+nodeList = NodeList(numNodes)
+nodeList.insertFieldVector2d("position")
+positions = nodeList.getFieldVector2d("position")
+for i in range(numNodes):
+    positions.setValue(i,Vector2d(Generator.positions[i][0],Generator.positions[i][1]))
+
+def bruteForce():
+    x = [(positions[i].x, positions[i].y) for i in range(numNodes)]
+    pairs = [[] for i in range(numNodes)]
+    for i in range(numNodes):
+        for j in range(i + 1, numNodes):
+            if (x[i][0] - x[j][0])**2 + (x[i][1] - x[j][1])**2 <= radius*radius:
+                pairs[i].append(j)
+                pairs[j].append(i)
+    return [sorted(p) for p in pairs]
+
+def withinRadius(neighborList, i):
+    xi = positions[i]
+    return sorted(j for j in neighborList.neighbors(i) if (positions[j] - xi).mag2 <= radius*radius)
+
+def mismatches(neighborList):
+    expected = bruteForce()
+    return sum(1 for i in range(numNodes) if withinRadius(neighborList, i) != expected[i])
+
+neighbors = NeighborList2d.get(nodeList,radius,skin)
+assert neighbors.update(positions)
+count = mismatches(neighbors)
+print("after the first build: %d nodes with the wrong neighbors" % count)
+assert count == 0
+
+# drift every node by less than skin/2, which the list has to absorb without a rebuild
+for i in range(numNodes):
+    step = 0.45*skin*random.random()
+    angle = 6.283185307179586*random.random()
+    positions.setValue(i,positions[i] + Vector2d(step*cos(angle),step*sin(angle)))
+assert not neighbors.update(positions), "rebuilt although no node moved skin/2"
+count = mismatches(neighbors)
+print("after drifting inside the skin: %d nodes with the wrong neighbors" % count)
+assert count == 0
+
+# one node jumping past skin/2 forces a rebuild
+positions.setValue(0,positions[0] + Vector2d(skin,0.0))
+assert neighbors.update(positions), "no rebuild after a node moved more than skin/2"
+assert mismatches(neighbors) == 0
+
+# a second caller asking for a larger skin gets its own list rather than the first one's
+wider = NeighborList2d.get(nodeList,radius,4.0*skin)
+same = NeighborList2d.get(nodeList,radius,skin)
+print("skins: %g, %g, %g; builds of the shared list: %d" % (neighbors.skin, wider.skin, same.skin, same.numBuilds()))
+assert wider.skin == 4.0*skin and same.skin == skin
+assert same.numBuilds() == neighbors.numBuilds()
+wider.update(positions)
+assert mismatches(wider) == 0
+
+# PhaseCoupling asks for radius r with skin r/5 and builds it on its first evaluation
+coupling = PhaseCoupling2d(nodeList,MKS(),1.0,2.0*radius)
+Integrator2d([coupling],dtmin=1e-3).Step()
+fromPhysics = NeighborList2d.get(nodeList,2.0*radius,0.2*(2.0*radius))
+print("builds of PhaseCoupling's list seen from Trees: %d" % fromPhysics.numBuilds())
+assert fromPhysics.numBuilds() == 1, "Trees did not get the list PhaseCoupling registered"
+print("passed")
@@ -0,0 +1,37 @@
+from yggdrasil import *
+from Physics import ParticleMeshGravity3d
+from Mesh import Grid3d
+
+# a unit point mass in the middle of an isolated 64^3 grid: a few cells out
+# the mesh force should match G m / r^2 to better than a percent
+commandLine = CommandLineArguments(nx = 64,
+                                   assignment = "TSC")
+
+# unit mass chosen so that G = 1
+constants = PhysicalConstants(1.0,1.0/6.6743e-11,1.0,1.0,1.0)
+
+numProbes = 7
+nodeList = NodeList(numProbes+1)
+grid = Grid3d(nx,nx,nx,1.0/nx,1.0/nx,1.0/nx)
+gravity = ParticleMeshGravity3d(nodeList,constants,grid,False,assignment)
+
+positions = nodeList.getFieldVector3d("position")
+mass = nodeList.getFieldDouble("mass")
+positions.setValue(0,Vector3d(0.5,0.5,0.5))
+mass.setValue(0,1.0)
+for i in range(1,numProbes+1):
+    r = 0.02*1.6**i
+    positions.setValue(i,Vector3d(0.5+0.8*r,0.5+0.6*r,0.5))
+    mass.setValue(i,1e-9)
+
+integrator = Integrator3d([gravity],dtmin=1e-8)
+integrator.Step()
+
+acceleration = nodeList.getFieldVector3d("acceleration")
+for i in range(1,numProbes+1):
+    r = (positions[i]-positions[0]).magnitude
+    ratio = acceleration[i].magnitude*r*r
+    print("r/dx = %5.1f  |a| r^2 / G m = %.4f"%(r*nx,ratio))
+    if r*nx >= 4:
+        assert abs(ratio - 1) < 0.01, "mesh force is off by more than a percent at r/dx = %.1f" % (r*nx)
+print("passed")
@@ -0,0 +1,60 @@
+from yggdrasil import *
+from Physics import WaveEquation2d, GridHydroHLLCMUSCLVanLeer2d
+from Mesh import Grid2d
+from EOS import IdealGasEOS
+from Boundaries import DirichletGridBoundary2d, ReflectingGridBoundary2d
+import time
+
+# Step time of the wave equation and grid hydro with their single-precision-capable
+# fields (soundSpeed and the wave diagnostics) stored as double and as float
+
+commandLine = CommandLineArguments(nx = 1000,
+                                   ny = 1000,
+                                   steps = 20)
+
+constants = PhysicalConstants(1.0,1.0,1.0,1.0,1.0)
+
+def waveRun(precision):
+    grid = Grid2d(nx,ny,1,1)
+    nodeList = NodeList(nx*ny)
+    wave = WaveEquation2d(nodeList,constants,grid,1.0,precision)
+    box = DirichletGridBoundary2d(grid=grid)
+    wave.addBoundary(box)
+    phi = nodeList.getFieldDouble("phi")
+    phi.setValue(grid.index(nx//2,ny//2,0),1.0)
+    integrator = RungeKutta4Integrator2d([wave],dtmin=0.1)
+    integrator.Step()
+    start = time.time()
+    for i in range(steps):
+        integrator.Step()
+    elapsed = time.time() - start
+    print("WaveEquation2d %s: %.2f ms/step" % (wave.precision,1e3*elapsed/steps))
+    return [phi[i] for i in range(0,nx*ny,97)]
+
+def hydroRun(precision):
+    grid = Grid2d(nx,ny//4,1,1)
+    nodeList = NodeList(nx*(ny//4))
+    eos = IdealGasEOS(1.4,constants)
+    hydro = GridHydroHLLCMUSCLVanLeer2d(nodeList,constants,eos,grid,precision)
+    box = ReflectingGridBoundary2d(grid=grid)
+    hydro.addBoundary(box)
+    density = nodeList.getFieldDouble("density")
+    energy = nodeList.getFieldDouble("specificInternalEnergy")
+    for j in range(ny//4):
+        for i in range(nx):
+            idx = grid.index(i,j,0)
+            density.setValue(idx, 1.0 if i < nx // 2 else 0.125)
+            energy.setValue(idx, 2.5 if i < nx // 2 else 2.0)
+    integrator = RungeKutta4Integrator2d([hydro],dtmin=0.001)
+    integrator.Step()
+    start = time.time()
+    for i in range(steps):
+        integrator.Step()
+    elapsed = time.time() - start
+    print("GridHydroHLLCMUSCLVanLeer2d %s: %.2f ms/step" % (hydro.precision,1e3*elapsed/steps))
+    return [density[i] for i in range(0,nx*(ny//4),97)]
+
+for run in [waveRun, hydroRun]:
+    double = run("double")
+    single = run("single")
+    print("  max difference:",max(abs(a-b) for a,b in zip(double,single)))
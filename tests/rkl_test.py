@@ -0,0 +1,58 @@
+from yggdrasil import *
+from Physics import ThermalConduction1d
+from Mesh import Grid1d
+from math import sin, exp, pi
+
+# A small sine mode of temperature in a 1D rod with its ends held fixed decays as
+# exp(-lambda t), lambda = D (4/dx^2) sin^2(pi dx/2L) for the discrete Laplacian. RKL1 and
+# RKL2 take steps of 20 and then 10 explicit timesteps; each should match the decay, with
+# the error halving (RKL1) or quartering (RKL2) as the step halves.
+commandLine = CommandLineArguments(n = 33,
+                                   stages = 10,
+                                   u0 = 1e6,
+                                   amplitude = 1e-6)
+
+constants = MKS()
+eos = IdealGasEOS(5.0/3.0,constants)
+opac = ConstantOpacity(1.0,constants)
+
+def setup():
+    grid = Grid1d(n,1.0)
+    nodeList = NodeList(n)
+    conduction = ThermalConduction1d(nodeList,constants,eos,opac,grid,"explicit")
+    density = nodeList.getFieldDouble("density")
+    energy = nodeList.getFieldDouble("specificInternalEnergy")
+    for i in range(n):
+        density.setValue(i,1.0)
+        energy.setValue(i,u0*(1.0 + amplitude*sin(pi*i/(n-1))))
+    return nodeList, conduction
+
+# the diffusivity X/(rho cv) at u0, read off an end cell, which never changes
+nodeList, conduction = setup()
+Integrator1d([conduction],dtmin=1e-3).Step()
+X = nodeList.getFieldDouble("conductivity")[0]
+T = nodeList.getFieldDouble("temperature")[0]
+D = X/(u0/T)
+explicitDt = 0.5/D
+decayRate = D*4.0*sin(pi/(2*(n-1)))**2
+
+errors = {}
+for order in [1,2]:
+    for multiple in [20,10]:
+        nodeList, conduction = setup()
+        integrator = RungeKuttaLegendreIntegrator1d([conduction],multiple*explicitDt,stages,order)
+        for step in range(200//multiple):
+            integrator.Step()
+        energy = nodeList.getFieldDouble("specificInternalEnergy")
+        measured = (energy[n//2]/u0 - 1.0)/amplitude
+        exact = exp(-decayRate*integrator.Time())
+        errors[(order,multiple)] = abs(measured/exact - 1.0)
+        print("RKL%d, dt = %d explicit steps: amplitude %.6f, exact %.6f, relative error %.3e"
+              % (order, multiple, measured, exact, errors[(order,multiple)]))
+
+for order, expected in [(1,2.0),(2,4.0)]:
+    ratio = errors[(order,20)]/errors[(order,10)]
+    print("RKL%d error ratio on halving dt: %.2f (expected about %g)" % (order, ratio, expected))
+    assert ratio > 0.8*expected, "RKL%d does not converge at order %d" % (order, order)
+assert errors[(1,20)] < 0.05 and errors[(2,20)] < 2e-3, "decay rate is off"
+print("passed")
@@ -15,7 +15,8 @@ if __name__ == "__main__":
                                         ny = 20,
                                         dx = 1,
                                         dy = 1,
-                                        dtmin = 0.001)
+                                        dtmin = 0.001,
+                                        gamma2 = 0.0)
 
     myGrid = Grid2d(nx,ny,dx,dy)
     print("grid size:",myGrid.size())
@@ -33,6 +34,12 @@ if __name__ == "__main__":
     print("numNodes =",myNodeList.numNodes)
     print("field names =",myNodeList.fieldNames)
 
+    # a second ideal gas on the low pressure side, as its own material
+    rightMaterial = 0
+    if gamma2 > 0:
+        eos2 = IdealGasEOS(gamma2,constants)
+        rightMaterial = hydro.AddMaterial(eos2)
+
     box = ReflectingGridBoundary2d(grid=myGrid)
     hydro.addBoundary(box)
 
@@ -40,6 +47,7 @@ if __name__ == "__main__":
 
     density = myNodeList.getFieldDouble("density")
     energy  = myNodeList.getFieldDouble("specificInternalEnergy")
+    material = myNodeList.getFieldInt("materialId")
 
     for j in range(ny):
         for i in range(nx):
@@ -50,6 +58,7 @@ if __name__ == "__main__":
             else:
                 density.setValue(idx, 0.125)
                 energy.setValue(idx, 2.0)   # low pressure side
+                material.setValue(idx, rightMaterial)
 
     periodicWork = []
     
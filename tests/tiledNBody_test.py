@@ -0,0 +1,33 @@
+from yggdrasil import *
+from Physics import NBodyGravity2d, TiledNBodyGravity2d
+from RandomNodeGenerator import RandomNodeGenerator2d
+import time
+
+commandLine = CommandLineArguments(numNodes = 2000)
+
+bounds = [[-1,-1],[1,1]]
+Generator = RandomNodeGenerator2d(numNodes=numNodes,bounds=bounds)
+constants = PhysicalConstants(1.0,1.0,1.0,1.0,1.0)
+
+def oneStep(gravityClass,**kwargs):
+    nodeList = NodeList(numNodes)
+    gravity = gravityClass(nodeList=nodeList,constants=constants,plummerLength=0.01,**kwargs)
+    positions = nodeList.getFieldVector2d("position")
+    mass = nodeList.getFieldDouble("mass")
+    for i in range(numNodes):
+        mass.setValue(i,1.0/numNodes)
+        positions.setValue(i,Vector2d(Generator.positions[i][0],Generator.positions[i][1]))
+    integrator = Integrator2d([gravity],dtmin=1e-4)
+    start = time.time()
+    integrator.Step()
+    print(gravityClass.__name__,kwargs,"%.3fs"%(time.time()-start))
+    return nodeList.getFieldVector2d("acceleration")
+
+ref = oneStep(NBodyGravity2d)
+for symmetric in [True,False]:
+    acc = oneStep(TiledNBodyGravity2d,symmetric=symmetric)
+    err = max((acc[i]-ref[i]).magnitude/ref[i].magnitude for i in range(numNodes))
+    print("max relative error against NBodyGravity2d:",err)
+    # the same force law summed in double, so only the order of the sums differs
+    assert err < 1e-10, "TiledNBodyGravity2d (symmetric=%s) disagrees with NBodyGravity2d" % symmetric
+print("passed")